@@ -1,11 +1,20 @@
 #include "atom.h"
+#include "factory.h"
 
 #include <algorithm>
 #include <stdexcept>
 
 Atom::Atom(const RelationSymbol &symbol, const std::vector<Term> &terms)
-    : AtomicFormula (), m_symbol(symbol), m_terms(terms)
+    : AtomicFormula (Kind::Atom), m_symbol(symbol), m_terms(terms)
 {
+    for (const Term &t : m_terms)
+    {
+        m_size += t->size();
+        m_depth = std::max(m_depth, t->depth() + 1);
+        m_varMask |= t->variablesMask();
+        m_looseBound = std::max(m_looseBound, t->looseBound());
+    }
+    m_ground = m_varMask == 0;
 }
 
 std::ostream& Atom::print(std::ostream &out) const
@@ -27,11 +36,21 @@ std::ostream& Atom::print(std::ostream &out) const
     }
 }
 
-bool Atom::equalTo(const Formula &f) const
+std::size_t Atom::shallowHash() const
 {
-    const Atom *pF = dynamic_cast<const Atom*>(f.get());
-    if (pF)
+    std::size_t h = std::hash<RelationSymbol>()(m_symbol);
+    for (const Term &t : m_terms)
     {
+        h = hashCombine(h, t->hash());
+    }
+    return h;
+}
+
+bool Atom::shallowEqualTo(const BaseFormula &f) const
+{
+    if (f.kind() == Kind::Atom)
+    {
+        const Atom *pF = static_cast<const Atom*>(&f);
         return symbol() == pF->symbol() && 
             m_terms.size() == pF->m_terms.size() &&
             std::equal(m_terms.cbegin(), m_terms.cend(), pF->m_terms.cbegin());
@@ -51,26 +70,76 @@ void Atom::getVars(VariablesSet &vars, bool free) const
     }
 }
 
+bool Atom::containsVariable(const Variable &v, bool free) const
+{
+    UNUSED_ARG(free);
+    for (const Term &t : m_terms)
+    {
+        if (t->hasVariable(v))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 Arity Atom::getArity() const
 {
 	return m_terms.size();
 }
 
-Formula Atom::substitute(const Variable &v, const Term &t) const
+Formula Atom::substitute(const Substitution &s, SubstitutionMemo &memo) const
 {
+    if (!(m_varMask & memo.domain))
+    {
+        return self();
+    }
+    auto memoIt = memo.formulas.find(this);
+    if (memoIt != memo.formulas.cend())
+    {
+        return memoIt->second;
+    }
+
+    std::vector<Term> modifiedTerms;
+    bool changed = false;
+    modifiedTerms.reserve(m_terms.size());
+    for (const Term &t : m_terms)
+    {
+        modifiedTerms.push_back(t->substitute(s, memo));
+        changed = changed || modifiedTerms.back() != t;
+    }
+    Formula result = changed ? Factory::make<Atom>(m_symbol, modifiedTerms)
+                             : self();
+    memo.formulas.emplace(this, result);
+    return result;
+}
+
+Formula Atom::abstractVariable(const Variable &v, unsigned index) const
+{
+    if (!(m_varMask & variableBit(v)))
+    {
+        return self();
+    }
     std::vector<Term> terms;
     terms.reserve(m_terms.size());
-    std::transform(m_terms.cbegin(), m_terms.cend(), std::back_inserter(terms), [&](const Term &el) { return el->substitute(v, t); });
-    return std::make_shared<Atom>(m_symbol, terms);
+    for (const Term &t : m_terms)
+    {
+        terms.push_back(t->abstractVariable(v, index));
+    }
+    return Factory::make<Atom>(m_symbol, terms);
 }
 
-Formula Atom::substitute(const Substitution &s) const
+Formula Atom::instantiateBound(unsigned index, const Term &t) const
 {
-    std::vector<Term> modifiedTerms;
-    modifiedTerms.reserve(m_terms.size());
-    for (const Term &t : m_terms)
+    if (m_looseBound <= index)
+    {
+        return self();
+    }
+    std::vector<Term> terms;
+    terms.reserve(m_terms.size());
+    for (const Term &term : m_terms)
     {
-        modifiedTerms.push_back(t->substitute(s));
+        terms.push_back(term->instantiateBound(index, t));
     }
-    return std::make_shared<Atom>(m_symbol, modifiedTerms);
+    return Factory::make<Atom>(m_symbol, terms);
 }
@@ -10,30 +10,38 @@
 
 class Atom;
 
-using AtomMap = std::map<RelationSymbol, std::tuple<std::vector<std::shared_ptr<Atom>>, Arity>>;
+using AtomMap = std::map<RelationSymbol, std::tuple<std::vector<Ref<Atom>>, Arity>>;
 
 class Atom : public AtomicFormula
 {
 public:
     Atom(const RelationSymbol &symbol, const std::vector<Term> &terms);
     
+    static inline bool isKind(Kind kind) { return kind == Kind::Atom; }
+    
     inline const RelationSymbol& symbol() const { return m_symbol; }
     
     inline const std::vector<Term>& operands() const { return m_terms; }
     
     virtual std::ostream& print(std::ostream & out) const;
   
-    virtual bool equalTo(const Formula & f) const;
-  
     virtual void getVars(VariablesSet & vars, bool free = false) const;
 
 	Arity getArity() const;
   
-    bool hasVariable(const Variable & v, bool free = false) const;
-  
-    virtual Formula substitute(const Variable & v, const Term & t) const;
+    virtual Formula substitute(const Substitution &s, SubstitutionMemo &memo) const;
+    
+    virtual Formula abstractVariable(const Variable & v, unsigned index) const;
     
-    virtual Formula substitute(const Substitution &s) const;
+    virtual Formula instantiateBound(unsigned index, const Term & t) const;
+
+protected:
+    virtual std::size_t shallowHash() const;
+    
+    virtual bool shallowEqualTo(const BaseFormula &f) const;
+    
+    virtual bool containsVariable(const Variable & v, bool free) const;
+
 private:
     /**
      * @brief m_symbol je simbol relacije, na primer '<' za relaciju 'manje od'
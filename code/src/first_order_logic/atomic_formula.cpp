@@ -1,25 +1,34 @@
 #include "atomic_formula.h"
 
-AtomicFormula::AtomicFormula()
-  : BaseFormula ()
+AtomicFormula::AtomicFormula(Kind kind)
+  : BaseFormula (kind)
 {
   
 }
 
-unsigned AtomicFormula::complexity() const
-{
-    return 0;  
-}
-
 void AtomicFormula::getVars(VariablesSet &vars, bool free) const
 {
     UNUSED_ARG(vars);
     UNUSED_ARG(free);
 }
 
-Formula AtomicFormula::substitute(const Variable &v, const Term &t) const
+Formula AtomicFormula::substitute(const Substitution &s, SubstitutionMemo &memo) const
+{
+    UNUSED_ARG(s);
+    UNUSED_ARG(memo);
+    return self();
+}
+
+Formula AtomicFormula::abstractVariable(const Variable &v, unsigned index) const
 {
     UNUSED_ARG(v);
+    UNUSED_ARG(index);
+    return self();
+}
+
+Formula AtomicFormula::instantiateBound(unsigned index, const Term &t) const
+{
+    UNUSED_ARG(index);
     UNUSED_ARG(t);
-    return std::const_pointer_cast<BaseFormula>(shared_from_this());
+    return self();
 }
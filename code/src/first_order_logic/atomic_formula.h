@@ -7,13 +7,17 @@
 class AtomicFormula : public BaseFormula
 {
 public:
-    AtomicFormula();
+    explicit AtomicFormula(Kind kind);
     
-    virtual unsigned complexity() const;
+    static inline bool isKind(Kind kind) { return kind == Kind::True || kind == Kind::False || kind == Kind::Atom; }
     
     virtual void getVars(VariablesSet & vars, bool free) const;
     
-    virtual Formula substitute(const Variable & v, const Term & t) const;
+    virtual Formula substitute(const Substitution &s, SubstitutionMemo &memo) const;
+    
+    virtual Formula abstractVariable(const Variable & v, unsigned index) const;
+    
+    virtual Formula instantiateBound(unsigned index, const Term & t) const;
 };
 
 #endif // ATOMICFORMULA_H
@@ -1,33 +1,129 @@
 #include "base_formula.h"
+#include "factory.h"
+#include "region.h"
+#include "visitor.h"
+#include "first_order_logic.h"
+#include "constants.h"
 
 #include <sstream>
-#include <typeinfo>
 
-BaseFormula::BaseFormula()
+BaseFormula::BaseFormula(Kind kind)
+    : m_kind(kind)
 {}
 
+void BaseFormula::accept(FormulaVisitor &visitor) const
+{
+    switch (m_kind)
+    {
+    case Kind::True:
+        visitor.visit(static_cast<const True&>(*this));
+        break;
+    case Kind::False:
+        visitor.visit(static_cast<const False&>(*this));
+        break;
+    case Kind::Atom:
+        visitor.visit(static_cast<const Atom&>(*this));
+        break;
+    case Kind::Not:
+        visitor.visit(static_cast<const Not&>(*this));
+        break;
+    case Kind::And:
+        visitor.visit(static_cast<const And&>(*this));
+        break;
+    case Kind::Or:
+        visitor.visit(static_cast<const Or&>(*this));
+        break;
+    case Kind::Imp:
+        visitor.visit(static_cast<const Imp&>(*this));
+        break;
+    case Kind::Iff:
+        visitor.visit(static_cast<const Iff&>(*this));
+        break;
+    case Kind::Forall:
+        visitor.visit(static_cast<const Forall&>(*this));
+        break;
+    case Kind::Exists:
+        visitor.visit(static_cast<const Exists&>(*this));
+        break;
+    }
+}
+
+void BaseFormula::destroy() const
+{
+    Region *region = m_region;
+    if (!region)
+    {
+        delete this;
+        return;
+    }
+    std::uint32_t size = m_allocSize;
+    this->~BaseFormula();
+    region->deallocate(const_cast<BaseFormula*>(this), size);
+    region->release();
+}
+
 BaseFormula::~BaseFormula()
-{}
+{
+    if (m_interned)
+    {
+        Factory::release(this);
+    }
+}
+
+std::size_t BaseFormula::shallowHash() const
+{
+    return 0;
+}
 
-bool BaseFormula::equalTo(const Formula &f) const
+bool BaseFormula::shallowEqualTo(const BaseFormula &f) const
 {
-    const BaseFormula *base = f.get();
-    return typeid (*this) == typeid (*base);
+    return m_kind == f.kind();
+}
+
+bool BaseFormula::alphaEquivalentTo(const BaseFormula &f) const
+{
+  /* Atomi i konstante ne sadrze kvantifikatore, pa su alfa-ekvivalentni samo ako su isti cvor */
+  UNUSED_ARG(f);
+  return false;
 }
 
 bool BaseFormula::hasVariable(const Variable &v, bool free) const
 {
-  VariablesSet vset;
-  getVars(vset, free);
-  return vset.find(v) != vset.cend();
+  if (!(m_varMask & variableBit(v)))
+  {
+    return false;
+  }
+  return containsVariable(v, free);
 }
 
-Formula BaseFormula::substitute(const Substitution &s) const
+bool BaseFormula::containsVariable(const Variable &v, bool free) const
+{
+  UNUSED_ARG(v);
+  UNUSED_ARG(free);
+  return false;
+}
+
+Formula BaseFormula::substitute(const Variable &v, const Term &t) const
 {
-    UNUSED_ARG(s);
-    return std::const_pointer_cast<BaseFormula>(shared_from_this());
+    if (!(m_varMask & variableBit(v)))
+    {
+        return self();
+    }
+    Substitution s;
+    s.emplace(v, t);
+    SubstitutionMemo memo(s);
+    return substitute(s, memo);
 }
 
+Formula BaseFormula::substitute(const Substitution &s) const
+{
+    if (s.empty() || m_ground)
+    {
+        return self();
+    }
+    SubstitutionMemo memo(s);
+    return substitute(s, memo);
+}
 
 std::string BaseFormula::getText()
 {
@@ -38,6 +134,11 @@ std::string BaseFormula::getText()
 	return str.str();
 }
 
+std::size_t FormulaHash::operator()(const Formula &f) const
+{
+    return f->hash();
+}
+
 std::ostream& operator<<(std::ostream &out, const Formula &f)
 {
     return f->print(out);
@@ -5,47 +5,206 @@
 #include "base_term.h"
 
 #include <iostream>
+#include <cstdint>
 #include <memory>
 
 class BaseFormula;
+class FormulaVisitor;
 
-using Formula = std::shared_ptr<BaseFormula>;
+using Formula = Ref<BaseFormula>;
 
-class BaseFormula : public std::enable_shared_from_this<BaseFormula>
+/**
+ * @brief FormulaHash - hesiranje formula u kontejnerima po strukturnom hesu
+ */
+struct FormulaHash
 {
+    std::size_t operator()(const Formula &f) const;
+};
+
+class BaseFormula : public RefCounted
+{
+    friend class Factory;
+
 public:
-    BaseFormula();
+    /**
+     * @brief Kind - oznaka konkretnog tipa formule, koristi se umesto RTTI-ja
+     */
+    enum class Kind : std::uint8_t
+    {
+        True,
+        False,
+        Atom,
+        Not,
+        And,
+        Or,
+        Imp,
+        Iff,
+        Forall,
+        Exists
+    };
+    
+    explicit BaseFormula(Kind kind);
+    
+    /**
+     * @brief kind - oznaka konkretnog tipa formule
+     */
+    inline Kind kind() const { return m_kind; }
+    
+    /**
+     * @brief accept - poziva odgovarajucu metodu posetioca na osnovu oznake tipa
+     */
+    void accept(FormulaVisitor &visitor) const;
     
     virtual ~BaseFormula();
     
     virtual std::ostream& print(std::ostream & out) const = 0;
     
-    virtual unsigned complexity() const = 0;
+    /**
+     * @brief complexity - broj veznika i kvantifikatora u formuli
+     */
+    inline unsigned complexity() const { return m_complexity; }
+    
+    /**
+     * @brief size - broj cvorova formule, ukljucujuci simbole u termovima
+     */
+    inline unsigned size() const { return m_size; }
+    
+    /**
+     * @brief depth - dubina formule, ukljucujuci dubinu termova
+     */
+    inline unsigned depth() const { return m_depth; }
+    
+    /**
+     * @brief variablesMask - potpis skupa svih promenljivih formule (slobodnih i vezanih)
+     */
+    inline VariablesMask variablesMask() const { return m_varMask; }
+    
+    /**
+     * @brief isGround - da li je formula bez slobodnih promenljivih
+     */
+    inline bool isGround() const { return m_ground; }
+    
+    /**
+     * @brief looseBound - za jedan veci od najveceg indeksa vezane promenljive koja nije vezana
+     * unutar formule, 0 ako je formula lokalno zatvorena
+     */
+    inline unsigned looseBound() const { return m_looseBound; }
   
-    virtual bool equalTo(const Formula & f) const;
+    /**
+     * @brief equalTo - sintaksna jednakost, formule se prave preko Factory-ja
+     * pa je dovoljno uporediti pokazivace
+     */
+    inline bool equalTo(const Formula & f) const { return this == f.get(); }
+    
+    /**
+     * @brief alphaEquivalent - jednakost do na imena vezanih promenljivih
+     * @details Vezane promenljive su zapisane indeksom, pa se formule razlikuju samo po imenima
+     * sacuvanim u kvantifikatorima, a ista formula je alfa-ekvivalentna sama sebi.
+     */
+    inline bool alphaEquivalent(const Formula & f) const { return this == f.get() || alphaEquivalentTo(*f); }
+    
+    /**
+     * @brief hash - strukturni hes formule
+     */
+    inline std::size_t hash() const { return m_hash; }
   
     virtual void getVars(VariablesSet & vars, bool free = false) const = 0;
   
+    /**
+     * @brief hasVariable - provera da li formula sadrzi promenljivu, bez pravljenja skupa promenljivih
+     * @param v - promenljiva
+     * @param free - ako je true, trazi se samo slobodno pojavljivanje
+     */
     bool hasVariable(const Variable & v, bool free = false) const;
   
-    virtual Formula substitute(const Variable & v, const Term & t) const = 0;
+    /**
+     * @brief substitute - zamena slobodne promenljive 'v' termom 't'
+     * @return izmenjena formula, ili ista formula ako se promenljiva u njoj ne javlja
+     */
+    Formula substitute(const Variable & v, const Term & t) const;
+    
+    Formula substitute(const Substitution &s) const;
     
-    virtual Formula substitute(const Substitution &s) const;
+    /**
+     * @brief substitute - supstitucija u okviru jednog poziva, nepromenjene potformule se vracaju kao isti cvor
+     * @param s - supstitucija
+     * @param memo - rezultati za vec obradjene potformule i podtermove u ovom pozivu
+     */
+    virtual Formula substitute(const Substitution &s, SubstitutionMemo &memo) const = 0;
+    
+    /**
+     * @brief abstractVariable - zamena slobodne promenljive 'v' vezanom promenljivom sa indeksom 'index'
+     * @details Indeks se uvecava za svaki kvantifikator kroz koji se prolazi.
+     */
+    virtual Formula abstractVariable(const Variable & v, unsigned index) const = 0;
+    
+    /**
+     * @brief instantiateBound - zamena vezane promenljive sa indeksom 'index' lokalno zatvorenim termom 't'
+     */
+    virtual Formula instantiateBound(unsigned index, const Term & t) const = 0;
 
 	std::string getText();
     
     template <typename Derived>
     static inline const Derived* isOfType(const Formula &f)
     {
-        return dynamic_cast<const Derived*>(f.get());
+        return Derived::isKind(f->kind()) ? static_cast<const Derived*>(f.get()) : nullptr;
     }
 
 	template <typename T>
-	bool IsA() { return dynamic_cast<T*>(this) != nullptr; }
+	bool IsA() const { return T::isKind(m_kind); }
 
 	template <typename T>
 	T* As() { return static_cast<T*>(this); }
+
+protected:
+    /**
+     * @brief self - referenca na tekucu formulu
+     */
+    inline Formula self() const { return Formula(const_cast<BaseFormula*>(this)); }
     
+    /**
+     * @brief destroy - unistava cvor i vraca memoriju regionu iz kog je alociran
+     */
+    virtual void destroy() const;
+    
+    /**
+     * @brief shallowHash - hes simbola i hesova neposrednih potformula i termova
+     */
+    virtual std::size_t shallowHash() const;
+    
+    /**
+     * @brief shallowEqualTo - jednakost cvora sa kandidatom, potformule i termovi
+     * se porede pokazivacem
+     */
+    virtual bool shallowEqualTo(const BaseFormula &f) const;
+    
+    /**
+     * @brief alphaEquivalentTo - rekurzivna provera za alphaEquivalent nad razlicitim cvorovima
+     */
+    virtual bool alphaEquivalentTo(const BaseFormula &f) const;
+    
+    /**
+     * @brief containsVariable - rekurzivna provera za hasVariable, poziva se tek kada
+     * potpis promenljivih dozvoljava da se promenljiva javlja u formuli
+     */
+    virtual bool containsVariable(const Variable & v, bool free) const;
+
+protected:
+    /* Metapodaci koje izvedene klase racunaju jednom, u konstruktoru */
+    unsigned m_size = 1;
+    unsigned m_depth = 1;
+    unsigned m_complexity = 0;
+    VariablesMask m_varMask = 0;
+    bool m_ground = true;
+    unsigned m_looseBound = 0;
+
+private:
+    std::size_t m_hash = 0;
+    Region *m_region = nullptr;
+    std::uint32_t m_allocSize = 0;
+    Kind m_kind;
+    bool m_interned = false;
 };
 
 std::ostream& operator<<(std::ostream &out, const Formula &f);
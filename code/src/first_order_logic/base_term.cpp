@@ -1,18 +1,90 @@
 #include "base_term.h"
+#include "factory.h"
+#include "region.h"
+#include "visitor.h"
+#include "variable_term.h"
+#include "function_term.h"
+#include "bound_variable_term.h"
 
-BaseTerm::BaseTerm()
+BaseTerm::BaseTerm(Kind kind)
+    : m_kind(kind)
 {
 }
 
+void BaseTerm::accept(TermVisitor &visitor) const
+{
+    switch (m_kind)
+    {
+    case Kind::Variable:
+        visitor.visit(static_cast<const VariableTerm&>(*this));
+        break;
+    case Kind::Function:
+        visitor.visit(static_cast<const FunctionTerm&>(*this));
+        break;
+    case Kind::Bound:
+        visitor.visit(static_cast<const BoundVariableTerm&>(*this));
+        break;
+    }
+}
+
+Term BaseTerm::substitute(const Variable &v, const Term &t) const
+{
+    if (!hasVariable(v))
+    {
+        return self();
+    }
+    Substitution s;
+    s.emplace(v, t);
+    SubstitutionMemo memo(s);
+    return substitute(s, memo);
+}
+
+Term BaseTerm::substitute(const Substitution &s) const
+{
+    if (s.empty() || isGround())
+    {
+        return self();
+    }
+    SubstitutionMemo memo(s);
+    return substitute(s, memo);
+}
+
+void BaseTerm::destroy() const
+{
+    Region *region = m_region;
+    if (!region)
+    {
+        delete this;
+        return;
+    }
+    std::uint32_t size = m_allocSize;
+    this->~BaseTerm();
+    region->deallocate(const_cast<BaseTerm*>(this), size);
+    region->release();
+}
+
 BaseTerm::~BaseTerm()
-{   
+{
+    if (m_interned)
+    {
+        Factory::release(this);
+    }
 }
 
-bool operator==(const Term &lhs, const Term &rhs)
+SubstitutionMemo::SubstitutionMemo(const Substitution &s)
 {
-    return lhs->equalTo(rhs);
+    for (const auto &varTermPair : s)
+    {
+        domain |= variableBit(varTermPair.first);
+    }
 }
 
+std::size_t TermHash::operator()(const Term &t) const
+{
+    return t->hash();
+}
+
+
 std::ostream &operator<<(std::ostream &out, const Term &t)
 {
     return t->print(out);
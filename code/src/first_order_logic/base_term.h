@@ -2,25 +2,87 @@
 #define BASETERM_H
 
 #include "common.h"
+#include "ref.h"
 
+#include <cstdint>
 #include <memory>
 #include <iostream>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 class BaseTerm;
+class BaseFormula;
+class Region;
+class TermVisitor;
 
-using Term = std::shared_ptr<BaseTerm>;
+using Term = Ref<BaseTerm>;
+
+/**
+ * @brief TermHash - hesiranje termova u kontejnerima po strukturnom hesu
+ */
+struct TermHash
+{
+    std::size_t operator()(const Term &t) const;
+};
 
 using Substitution = std::map<Variable, Term>;
 
-class BaseTerm : public std::enable_shared_from_this<BaseTerm>
+/**
+ * @brief SubstitutionMemo - stanje jednog poziva supstitucije
+ *
+ * @details Pamti rezultate za vec obradjene unutrasnje cvorove, pa se deljeni podtermovi
+ * i potformule (koji su zbog Factory-ja cesti) menjaju samo jednom. Cuva i potpis domena
+ * supstitucije, pa se podstabla bez promenljivih iz domena vracaju nepromenjena bez obilaska.
+ */
+struct SubstitutionMemo
+{
+    explicit SubstitutionMemo(const Substitution &s);
+
+    VariablesMask domain = 0;
+    std::unordered_map<const BaseTerm*, Term> terms;
+    std::unordered_map<const BaseFormula*, Ref<BaseFormula>> formulas;
+};
+
+class BaseTerm : public RefCounted
 {
+    friend class Factory;
+
 public:
+    /**
+     * @brief Kind - oznaka konkretnog tipa terma, koristi se umesto RTTI-ja
+     */
+    enum class Kind : std::uint8_t
+    {
+        Variable,
+        Function,
+        Bound
+    };
+    
     /**
      * @brief BaseTerm konstruktor
+     * @param kind - oznaka konkretnog tipa terma
+     */
+    explicit BaseTerm(Kind kind);
+    
+    /**
+     * @brief kind - oznaka konkretnog tipa terma
      */
-    BaseTerm();
+    inline Kind kind() const { return m_kind; }
+    
+    /**
+     * @brief accept - poziva odgovarajucu metodu posetioca na osnovu oznake tipa
+     */
+    void accept(TermVisitor &visitor) const;
+    
+    /**
+     * @brief isOfType - vraca pokazivac na konkretan tip ako je term tog tipa, nullptr inace
+     */
+    template <typename Derived>
+    static inline const Derived* isOfType(const Term &t)
+    {
+        return Derived::isKind(t->kind()) ? static_cast<const Derived*>(t.get()) : nullptr;
+    }
     
     /**
      * @brief print - stampa term u C++ stream
@@ -31,10 +93,43 @@ public:
     
     /**
      * @brief equalTo - provera sintaksne jednakosti dva terma
+     * @details Termovi se prave preko Factory-ja pa su sintaksno jednaki termovi
+     * isti objekat i dovoljno je uporediti pokazivace
      * @param oth - term sa kojim se tekuci objekat poredi
      * @return true ako su sintaksno jednaki, false inace
      */
-    virtual bool equalTo(const Term &oth) const = 0;
+    inline bool equalTo(const Term &oth) const { return this == oth.get(); }
+    
+    /**
+     * @brief hash - strukturni hes terma
+     */
+    inline std::size_t hash() const { return m_hash; }
+    
+    /**
+     * @brief size - broj simbola (promenljivih i funkcijskih simbola) u termu
+     */
+    inline unsigned size() const { return m_size; }
+    
+    /**
+     * @brief depth - dubina terma, promenljive i konstante imaju dubinu 1
+     */
+    inline unsigned depth() const { return m_depth; }
+    
+    /**
+     * @brief variablesMask - potpis skupa promenljivih terma
+     */
+    inline VariablesMask variablesMask() const { return m_varMask; }
+    
+    /**
+     * @brief isGround - da li je term bez slobodnih promenljivih
+     */
+    inline bool isGround() const { return m_varMask == 0; }
+    
+    /**
+     * @brief looseBound - za jedan veci od najveceg indeksa vezane promenljive koja nije vezana
+     * unutar terma, 0 ako term ne sadrzi vezane promenljive (lokalno je zatvoren)
+     */
+    inline unsigned looseBound() const { return m_looseBound; }
     
     /**
      * @brief getVariables - dohvatanje svih promenljivih koje se javljaju u termu
@@ -53,19 +148,70 @@ public:
      * @brief substitute - zamena promenljive 'v' sa termom 't' u tekucem termu
      * @param v - promenljiva koja se menja
      * @param t - term kojim se promenljiva menja
-     * @return izmenjeni term
+     * @return izmenjeni term, ili isti term ako se promenljiva u njemu ne javlja
+     */
+    Term substitute(const Variable &v, const Term &t) const;
+    
+    Term substitute(const Substitution &s) const;
+    
+    /**
+     * @brief substitute - supstitucija u okviru jednog poziva, nepromenjeni podtermovi se vracaju kao isti cvor
+     * @param s - supstitucija
+     * @param memo - rezultati za vec obradjene podtermove u ovom pozivu
+     */
+    virtual Term substitute(const Substitution &s, SubstitutionMemo &memo) const = 0;
+    
+    /**
+     * @brief abstractVariable - zamena slobodne promenljive 'v' vezanom promenljivom sa indeksom 'index'
+     * @details Koristi se pri pravljenju kvantifikatora u lokalno bezimenom zapisu.
      */
-    virtual Term substitute(const Variable &v, const Term &t) const = 0;
+    virtual Term abstractVariable(const Variable &v, unsigned index) const = 0;
     
-    virtual Term substitute(const Substitution &s) const = 0;
+    /**
+     * @brief instantiateBound - zamena vezane promenljive sa indeksom 'index' lokalno zatvorenim termom 't'
+     */
+    virtual Term instantiateBound(unsigned index, const Term &t) const = 0;
     
     /**
      * @brief ~BaseTerm destruktor
      */
     virtual ~BaseTerm();
-};
 
-bool operator==(const Term &lhs, const Term &rhs);
+protected:
+    /**
+     * @brief self - referenca na tekuci cvor
+     */
+    inline Term self() const { return Term(const_cast<BaseTerm*>(this)); }
+    
+    /**
+     * @brief destroy - unistava cvor i vraca memoriju regionu iz kog je alociran
+     */
+    virtual void destroy() const;
+    
+    /**
+     * @brief shallowHash - hes simbola i hesova neposrednih podtermova
+     */
+    virtual std::size_t shallowHash() const = 0;
+    
+    /**
+     * @brief shallowEqualTo - jednakost cvora sa kandidatom, podtermovi se porede pokazivacem
+     */
+    virtual bool shallowEqualTo(const BaseTerm &oth) const = 0;
+
+protected:
+    /* Metapodaci koje izvedene klase racunaju jednom, u konstruktoru */
+    unsigned m_size = 1;
+    unsigned m_depth = 1;
+    VariablesMask m_varMask = 0;
+    unsigned m_looseBound = 0;
+
+private:
+    std::size_t m_hash = 0;
+    Region *m_region = nullptr;
+    std::uint32_t m_allocSize = 0;
+    Kind m_kind;
+    bool m_interned = false;
+};
 
 std::ostream& operator<<(std::ostream &out, const Term &t);
 
@@ -1,27 +1,53 @@
 #include "binary_connective.h"
+#include "and.h"
+#include "or.h"
+#include "imp.h"
+#include "iff.h"
 
+#include <algorithm>
 #include <stdexcept>
 
-BinaryConnective::BinaryConnective(const Formula &op1, const Formula &op2)
-  : BaseFormula (), m_op1(op1), m_op2(op2)
+BinaryConnective::BinaryConnective(Kind kind, const Formula &op1, const Formula &op2)
+  : BaseFormula (kind), m_op1(op1), m_op2(op2)
 {
+  m_size = 1 + m_op1->size() + m_op2->size();
+  m_depth = 1 + std::max(m_op1->depth(), m_op2->depth());
+  m_complexity = 1 + m_op1->complexity() + m_op2->complexity();
+  m_varMask = m_op1->variablesMask() | m_op2->variablesMask();
+  m_ground = m_op1->isGround() && m_op2->isGround();
+  m_looseBound = std::max(m_op1->looseBound(), m_op2->looseBound());
 }
 
-unsigned BinaryConnective::complexity() const
+std::size_t BinaryConnective::shallowHash() const
 {
-  return 1 + m_op1->complexity() + m_op2->complexity();
+  return hashCombine(m_op1->hash(), m_op2->hash());
 }
 
-bool BinaryConnective::equalTo(const Formula &f) const
+bool BinaryConnective::shallowEqualTo(const BaseFormula &f) const
 {
-  if (BaseFormula::equalTo(f))
+  if (BaseFormula::shallowEqualTo(f))
   {
-    return m_op1->equalTo(static_cast<const BinaryConnective*>(f.get())->m_op1) &&
-        m_op2->equalTo(static_cast<const BinaryConnective*>(f.get())->m_op2);
+    return m_op1->equalTo(static_cast<const BinaryConnective&>(f).m_op1) &&
+        m_op2->equalTo(static_cast<const BinaryConnective&>(f).m_op2);
   }
   return false;
 }
 
+bool BinaryConnective::alphaEquivalentTo(const BaseFormula &f) const
+{
+  if (BaseFormula::shallowEqualTo(f))
+  {
+    return m_op1->alphaEquivalent(static_cast<const BinaryConnective&>(f).m_op1) &&
+        m_op2->alphaEquivalent(static_cast<const BinaryConnective&>(f).m_op2);
+  }
+  return false;
+}
+
+bool BinaryConnective::containsVariable(const Variable &v, bool free) const
+{
+  return m_op1->hasVariable(v, free) || m_op2->hasVariable(v, free);
+}
+
 void BinaryConnective::getVars(VariablesSet &vars, bool free) const
 {
   m_op1->getVars(vars, free);
@@ -36,3 +62,56 @@ std::ostream &BinaryConnective::printImpl(std::ostream &out, const std::string &
   m_op2->print(out);
   return out << ')';
 }
+
+Formula BinaryConnective::rebuild(const Formula &op1, const Formula &op2) const
+{
+  if (op1 == m_op1 && op2 == m_op2)
+  {
+    return self();
+  }
+  switch (kind())
+  {
+  case Kind::And:
+    return Factory::make<And>(op1, op2);
+  case Kind::Or:
+    return Factory::make<Or>(op1, op2);
+  case Kind::Imp:
+    return Factory::make<Imp>(op1, op2);
+  default:
+    return Factory::make<Iff>(op1, op2);
+  }
+}
+
+Formula BinaryConnective::substitute(const Substitution &s, SubstitutionMemo &memo) const
+{
+  if (!(m_varMask & memo.domain))
+  {
+    return self();
+  }
+  auto memoIt = memo.formulas.find(this);
+  if (memoIt != memo.formulas.cend())
+  {
+    return memoIt->second;
+  }
+  Formula result = rebuild(m_op1->substitute(s, memo), m_op2->substitute(s, memo));
+  memo.formulas.emplace(this, result);
+  return result;
+}
+
+Formula BinaryConnective::abstractVariable(const Variable &v, unsigned index) const
+{
+  if (!(m_varMask & variableBit(v)))
+  {
+    return self();
+  }
+  return rebuild(m_op1->abstractVariable(v, index), m_op2->abstractVariable(v, index));
+}
+
+Formula BinaryConnective::instantiateBound(unsigned index, const Term &t) const
+{
+  if (m_looseBound <= index)
+  {
+    return self();
+  }
+  return rebuild(m_op1->instantiateBound(index, t), m_op2->instantiateBound(index, t));
+}
@@ -2,6 +2,7 @@
 #define BINARYCONNECTIVE_H
 
 #include "base_formula.h"
+#include "factory.h"
 
 #define GET_OPERANDS_EXT(f, op1, op2) \
     Formula op1, op2; \
@@ -10,31 +11,39 @@
 class BinaryConnective : public BaseFormula
 {
 public:
-    BinaryConnective(const Formula &op1, const Formula &op2);
+    BinaryConnective(Kind kind, const Formula &op1, const Formula &op2);
+    
+    static inline bool isKind(Kind kind) { return kind == Kind::And || kind == Kind::Or || kind == Kind::Imp || kind == Kind::Iff; }
     
-    virtual unsigned complexity() const;
-  
-    virtual bool equalTo(const Formula & f) const;
-  
     virtual void getVars(VariablesSet & vars, bool free = false) const;
   
     inline std::pair<Formula, Formula> operands() const { return {m_op1, m_op2}; }
+    
+    virtual Formula substitute(const Substitution &s, SubstitutionMemo &memo) const;
+    
+    virtual Formula abstractVariable(const Variable & v, unsigned index) const;
+    
+    virtual Formula instantiateBound(unsigned index, const Term & t) const;
 
 protected:
-    template <typename Derived>
-    Formula substituteImpl(const Variable & v, const Term & t) const;
+    /**
+     * @brief rebuild - formula istog veznika sa novim operandima, ista formula ako se operandi nisu promenili
+     */
+    Formula rebuild(const Formula &op1, const Formula &op2) const;
     
     std::ostream& printImpl(std::ostream &out, const std::string &symbol) const;
     
+    virtual std::size_t shallowHash() const;
+    
+    virtual bool shallowEqualTo(const BaseFormula &f) const;
+    
+    virtual bool alphaEquivalentTo(const BaseFormula &f) const;
+    
+    virtual bool containsVariable(const Variable & v, bool free) const;
+    
 protected:
     Formula m_op1;
     Formula m_op2;
 };
 
-template <typename Derived>
-Formula BinaryConnective::substituteImpl(const Variable &v, const Term &t) const
-{
-  return std::make_shared<Derived>(m_op1->substitute(v, t), m_op2->substitute(v, t));
-}
-
 #endif // BINARYCONNECTIVE_H
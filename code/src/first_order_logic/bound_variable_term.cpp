@@ -0,0 +1,63 @@
+#include "bound_variable_term.h"
+
+BoundVariableTerm::BoundVariableTerm(unsigned index)
+    : BaseTerm (Kind::Bound), m_index{index}
+{
+    m_looseBound = m_index + 1;
+}
+
+std::ostream &BoundVariableTerm::print(std::ostream &out) const
+{
+    return out << '#' << m_index;
+}
+
+std::size_t BoundVariableTerm::shallowHash() const
+{
+    return std::hash<unsigned>()(m_index);
+}
+
+bool BoundVariableTerm::shallowEqualTo(const BaseTerm &oth) const
+{
+    if (oth.kind() == Kind::Bound)
+    {
+        return static_cast<const BoundVariableTerm&>(oth).index() == m_index;
+    }
+    else
+    {
+        return false;
+    }
+}
+
+void BoundVariableTerm::getVariables(VariablesSet &vset) const
+{
+    UNUSED_ARG(vset);
+}
+
+bool BoundVariableTerm::hasVariable(const Variable &v) const
+{
+    UNUSED_ARG(v);
+    return false;
+}
+
+Term BoundVariableTerm::substitute(const Substitution &s, SubstitutionMemo &memo) const
+{
+    UNUSED_ARG(s);
+    UNUSED_ARG(memo);
+    return self();
+}
+
+Term BoundVariableTerm::abstractVariable(const Variable &v, unsigned index) const
+{
+    UNUSED_ARG(v);
+    UNUSED_ARG(index);
+    return self();
+}
+
+Term BoundVariableTerm::instantiateBound(unsigned index, const Term &t) const
+{
+    if (index == m_index)
+    {
+        return t;
+    }
+    return self();
+}
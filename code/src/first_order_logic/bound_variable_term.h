@@ -0,0 +1,47 @@
+#ifndef BOUNDVARIABLETERM_H
+#define BOUNDVARIABLETERM_H
+
+#include "base_term.h"
+
+/**
+ * @brief BoundVariableTerm - promenljiva vezana kvantifikatorom, zapisana de Bruijn-ovim indeksom
+ *
+ * @details Indeks 0 oznacava promenljivu najblizeg kvantifikatora iznad pojavljivanja, indeks 1
+ * promenljivu sledeceg kvantifikatora itd. Vezane promenljive nemaju ime, pa supstitucija ispod
+ * kvantifikatora nikada ne zahteva preimenovanje.
+ * Ovakvi termovi postoje samo unutar tela kvantifikatora (Quantifier::body).
+ */
+class BoundVariableTerm : public BaseTerm
+{
+public:
+    BoundVariableTerm(unsigned index = 0);
+    
+    static inline bool isKind(Kind kind) { return kind == Kind::Bound; }
+    
+    inline unsigned index() const { return m_index; }
+    
+    virtual std::ostream& print(std::ostream &out) const;
+    
+    virtual void getVariables(VariablesSet &vset) const;
+    
+    virtual bool hasVariable(const Variable &v) const;
+    
+    virtual Term substitute(const Substitution &s, SubstitutionMemo &memo) const;
+    
+    virtual Term abstractVariable(const Variable &v, unsigned index) const;
+    
+    virtual Term instantiateBound(unsigned index, const Term &t) const;
+
+protected:
+    virtual std::size_t shallowHash() const;
+    
+    virtual bool shallowEqualTo(const BaseTerm &oth) const;
+
+private:
+    /**
+     * @brief m_index je de Bruijn-ov indeks vezane promenljive
+     */
+    unsigned m_index;
+};
+
+#endif // BOUNDVARIABLETERM_H
@@ -0,0 +1,72 @@
+#include "clause_store.h"
+#include "factory.h"
+#include "not.h"
+
+#include <algorithm>
+#include <iterator>
+
+ClauseLiteral ClauseLiteral::fromFormula(const Formula &l)
+{
+    if (l->kind() == BaseFormula::Kind::Not)
+    {
+        return ClauseLiteral(static_cast<const Atom*>(static_cast<const Not*>(l.get())->operand().get()), true);
+    }
+    return ClauseLiteral(static_cast<const Atom*>(l.get()), false);
+}
+
+Formula ClauseLiteral::toFormula() const
+{
+    Formula a(const_cast<Atom*>(atom()));
+    return negated() ? Factory::make<Not>(a) : a;
+}
+
+ClauseLiteral ClauseLiteral::substitute(const Substitution &s) const
+{
+    /* Rezultat supstitucije zivi dok novi literal ne uzme referencu na njega */
+    Formula a = static_cast<const BaseFormula*>(atom())->substitute(s);
+    return ClauseLiteral(static_cast<const Atom*>(a.get()), negated());
+}
+
+bool ClauseView::tautology() const
+{
+    for (const ClauseLiteral *l = m_begin; l + 1 < m_end; ++l)
+    {
+        if (l->complementOf(l[1]))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ClauseStore::normalize(std::vector<ClauseLiteral> &literals)
+{
+    std::sort(literals.begin(), literals.end());
+    literals.erase(std::unique(literals.begin(), literals.end()), literals.end());
+}
+
+std::uint32_t ClauseStore::add(std::vector<ClauseLiteral> literals)
+{
+    normalize(literals);
+    std::uint32_t idx = static_cast<std::uint32_t>(size());
+    m_literals.insert(m_literals.end(), std::make_move_iterator(literals.begin()), std::make_move_iterator(literals.end()));
+    m_offsets.push_back(static_cast<std::uint32_t>(m_literals.size()));
+    return idx;
+}
+
+std::uint32_t ClauseStore::add(const std::vector<Formula> &literals)
+{
+    std::vector<ClauseLiteral> converted;
+    converted.reserve(literals.size());
+    for (const Formula &l : literals)
+    {
+        converted.push_back(ClauseLiteral::fromFormula(l));
+    }
+    return add(std::move(converted));
+}
+
+void ClauseStore::clear()
+{
+    m_literals.clear();
+    m_offsets.assign(1, 0);
+}
@@ -0,0 +1,182 @@
+#ifndef CLAUSESTORE_H
+#define CLAUSESTORE_H
+
+#include "atom.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief ClauseLiteral - literal klauze: atom i bit znaka spakovani u jednu rec
+ *
+ * @details Cvorovi formula su poravnati bar na 2 bajta, pa je najnizi bit pokazivaca na
+ * atom slobodan i u njemu se cuva znak. Negativan literal zato nije zaseban Not cvor, a
+ * komplementarni literali se razlikuju samo u tom bitu. Literal drzi referencu na svoj atom.
+ */
+class ClauseLiteral
+{
+public:
+    ClauseLiteral() = default;
+
+    ClauseLiteral(const Atom *atom, bool negated)
+        : m_bits(reinterpret_cast<std::uintptr_t>(atom) | static_cast<std::uintptr_t>(negated))
+    {
+        if (atom)
+        {
+            atom->addRef();
+        }
+    }
+
+    ClauseLiteral(const ClauseLiteral &oth)
+        : ClauseLiteral(oth.atom(), oth.negated())
+    {
+    }
+
+    ClauseLiteral(ClauseLiteral &&oth) noexcept
+        : m_bits(oth.m_bits)
+    {
+        oth.m_bits = 0;
+    }
+
+    ~ClauseLiteral()
+    {
+        if (atom())
+        {
+            atom()->release();
+        }
+    }
+
+    ClauseLiteral& operator=(ClauseLiteral oth)
+    {
+        std::swap(m_bits, oth.m_bits);
+        return *this;
+    }
+
+    /**
+     * @brief fromFormula - literal iz atoma ili negacije atoma
+     */
+    static ClauseLiteral fromFormula(const Formula &l);
+
+    /**
+     * @brief toFormula - literal kao atom ili kao Not cvor napravljen preko Factory-ja
+     */
+    Formula toFormula() const;
+
+    /**
+     * @brief substitute - literal sa supstitucijom primenjenom na atom
+     */
+    ClauseLiteral substitute(const Substitution &s) const;
+
+    inline const Atom* atom() const { return reinterpret_cast<const Atom*>(m_bits & ~static_cast<std::uintptr_t>(1)); }
+
+    inline bool negated() const { return m_bits & 1; }
+
+    /**
+     * @brief complementOf - da li je literal 'oth' negacija tekuceg literala
+     */
+    inline bool complementOf(const ClauseLiteral &oth) const { return (m_bits ^ oth.m_bits) == 1; }
+
+    inline bool operator==(const ClauseLiteral &oth) const { return m_bits == oth.m_bits; }
+
+    inline bool operator!=(const ClauseLiteral &oth) const { return m_bits != oth.m_bits; }
+
+    /**
+     * @brief operator < - poredak literala u klauzi: po hesu atoma, pa po atomu, pa pozitivan pre negativnog
+     * @details Hes je strukturni, pa poredak ne zavisi od adresa cvorova (osim kod sudara), a
+     * svi literali istog atoma su susedni.
+     */
+    inline bool operator<(const ClauseLiteral &oth) const
+    {
+        std::size_t h1 = atom()->hash(), h2 = oth.atom()->hash();
+        return h1 != h2 ? h1 < h2 : m_bits < oth.m_bits;
+    }
+
+private:
+    std::uintptr_t m_bits = 0;
+};
+
+/**
+ * @brief ClauseView - klauza kao neprekidan niz uredjenih literala bez ponavljanja
+ *
+ * @details Pogled pokazuje na literale u skladistu, pa vazi samo dok se u skladiste ne doda
+ * nova klauza.
+ */
+class ClauseView
+{
+public:
+    ClauseView(const ClauseLiteral *begin, const ClauseLiteral *end)
+        : m_begin(begin), m_end(end)
+    {
+    }
+
+    inline const ClauseLiteral* begin() const { return m_begin; }
+
+    inline const ClauseLiteral* end() const { return m_end; }
+
+    inline std::size_t size() const { return static_cast<std::size_t>(m_end - m_begin); }
+
+    inline bool empty() const { return m_begin == m_end; }
+
+    inline const ClauseLiteral& operator[](std::size_t i) const { return m_begin[i]; }
+
+    /**
+     * @brief tautology - da li klauza sadrzi literal i njegovu negaciju, komplementi su susedni
+     */
+    bool tautology() const;
+
+private:
+    const ClauseLiteral *m_begin;
+    const ClauseLiteral *m_end;
+};
+
+/**
+ * @brief ClauseStore - skladiste klauza: literali svih klauza u jednom nizu, klauza je deo
+ * niza izmedju dva pomeraja
+ *
+ * @details Literali klauze se pri dodavanju uredjuju i izbacuju se ponovljeni, pa se provera
+ * tautologije i jednakosti literala svodi na jedan prolaz. Klauze se samo dodaju, a na njih
+ * se poziva indeksom.
+ */
+class ClauseStore
+{
+public:
+    /**
+     * @brief normalize - uredjuje literale i izbacuje ponovljene
+     */
+    static void normalize(std::vector<ClauseLiteral> &literals);
+
+    /**
+     * @brief add - dodaje klauzu u skladiste
+     * @return indeks dodate klauze
+     */
+    std::uint32_t add(std::vector<ClauseLiteral> literals);
+
+    /**
+     * @brief add - dodaje klauzu zadatu literalima kao formulama (atomima i negacijama atoma)
+     */
+    std::uint32_t add(const std::vector<Formula> &literals);
+
+    inline ClauseView operator[](std::uint32_t idx) const
+    {
+        return ClauseView(m_literals.data() + m_offsets[idx], m_literals.data() + m_offsets[idx + 1]);
+    }
+
+    /**
+     * @brief size - broj klauza u skladistu
+     */
+    inline std::size_t size() const { return m_offsets.size() - 1; }
+
+    /**
+     * @brief literalCount - ukupan broj literala svih klauza
+     */
+    inline std::size_t literalCount() const { return m_literals.size(); }
+
+    void clear();
+
+private:
+    std::vector<ClauseLiteral> m_literals;
+    std::vector<std::uint32_t> m_offsets{0};
+};
+
+#endif // CLAUSESTORE_H
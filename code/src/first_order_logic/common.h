@@ -1,15 +1,40 @@
 #ifndef COMMON_H
 #define COMMON_H
 
+#include "symbol_table.h"
+
+#include <cstdint>
 #include <string>
 #include <unordered_set>
 
 #define UNUSED_ARG(x) ((void)x)
 
-using Variable = std::string;
-using FunctionSymbol = std::string;
-using RelationSymbol = std::string;
+using Variable = Symbol;
+using FunctionSymbol = Symbol;
+using RelationSymbol = Symbol;
 using Arity = std::size_t;
 using VariablesSet = std::unordered_set<Variable>;
 
+/**
+ * Kompaktan potpis skupa promenljivih: promenljiva 'v' postavlja bit (v.id() mod 64).
+ * Ako bit nije postavljen promenljiva sigurno nije u skupu, obrnuto ne vazi.
+ */
+using VariablesMask = std::uint64_t;
+
+inline VariablesMask variableBit(const Variable &v)
+{
+    return VariablesMask(1) << (v.id() & 63);
+}
+
+/**
+ * @brief hashCombine - kombinuje hes vrednost 'value' sa tekucim hesom 'seed'
+ * @param seed - tekuca hes vrednost
+ * @param value - hes vrednost koja se dodaje
+ * @return kombinovana hes vrednost
+ */
+inline std::size_t hashCombine(std::size_t seed, std::size_t value)
+{
+    return seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2));
+}
+
 #endif // COMMON_H
@@ -2,7 +2,7 @@
 
 
 True::True()
-  : AtomicFormula ()
+  : AtomicFormula (Kind::True)
 {
   
 }
@@ -13,7 +13,7 @@ std::ostream &True::print(std::ostream &out) const
 }
 
 False::False()
-  : AtomicFormula ()
+  : AtomicFormula (Kind::False)
 {
   
 }
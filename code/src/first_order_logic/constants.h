@@ -8,6 +8,8 @@ class True : public AtomicFormula
 public:
     True();
     
+    static inline bool isKind(Kind kind) { return kind == Kind::True; }
+    
     virtual std::ostream& print(std::ostream & out) const;
 };
 
@@ -16,6 +18,8 @@ class False : public AtomicFormula
 public:
     False();
     
+    static inline bool isKind(Kind kind) { return kind == Kind::False; }
+    
     virtual std::ostream& print(std::ostream & out) const;
 };
 
@@ -0,0 +1,321 @@
+#include "discrimination_tree.h"
+#include "atom.h"
+
+#include <algorithm>
+#include <utility>
+
+struct DiscriminationTree::Node
+{
+    /* Dece je obicno malo, pa je linearna pretraga niza brza od mape */
+    std::vector<std::pair<Key, std::unique_ptr<Node>>> children;
+    std::vector<Entry> entries;
+
+    const Node* child(const Key &key) const
+    {
+        for (const auto &c : children)
+        {
+            if (c.first == key)
+            {
+                return c.second.get();
+            }
+        }
+        return nullptr;
+    }
+
+    Node* child(const Key &key, bool create)
+    {
+        for (auto &c : children)
+        {
+            if (c.first == key)
+            {
+                return c.second.get();
+            }
+        }
+        if (!create)
+        {
+            return nullptr;
+        }
+        children.emplace_back(key, std::unique_ptr<Node>(new Node()));
+        return children.back().second.get();
+    }
+};
+
+using Node = DiscriminationTree::Node;
+using Key = DiscriminationTree::Key;
+using Entry = DiscriminationTree::Entry;
+
+/**
+ * @brief keyOf - kljuc funkcijskog simbola iz celije ravnog terma
+ */
+static inline Key keyOf(const FlatCell &cell)
+{
+    return Key{cell.symbol.id(), cell.arity};
+}
+
+FlatTerm flatten(const Atom *atom)
+{
+    FlatTerm f;
+    std::uint32_t pos = f.appendSymbol(atom->symbol(), static_cast<std::uint32_t>(atom->operands().size()));
+    for (const Term &op : atom->operands())
+    {
+        f.append(op.get());
+    }
+    f.close(pos);
+    return f;
+}
+
+DiscriminationTree::DiscriminationTree()
+{
+    clear();
+}
+
+DiscriminationTree::~DiscriminationTree() = default;
+
+void DiscriminationTree::clear()
+{
+    m_roots[0].reset(new Node());
+    m_roots[1].reset(new Node());
+    m_size = 0;
+}
+
+void DiscriminationTree::path(const Atom *atom, std::vector<Key> &keys)
+{
+    FlatTerm f = flatten(atom);
+    std::vector<Variable> vars;
+    keys.clear();
+    keys.reserve(f.size());
+    for (std::size_t i = 0; i < f.size(); ++i)
+    {
+        if (!f[i].isVariable())
+        {
+            keys.push_back(keyOf(f[i]));
+            continue;
+        }
+
+        /* Promenljive se numerisu redom prvog pojavljivanja */
+        auto it = std::find(vars.cbegin(), vars.cend(), f[i].symbol);
+        std::uint32_t number = static_cast<std::uint32_t>(it - vars.cbegin());
+        if (it == vars.cend())
+        {
+            vars.push_back(f[i].symbol);
+        }
+        keys.push_back(Key{number, FlatCell::VariableArity});
+    }
+}
+
+void DiscriminationTree::insert(const Atom *atom, bool negated, const Entry &entry)
+{
+    std::vector<Key> keys;
+    path(atom, keys);
+
+    Node *node = m_roots[negated].get();
+    for (const Key &key : keys)
+    {
+        node = node->child(key, true);
+    }
+    node->entries.push_back(entry);
+    ++m_size;
+}
+
+bool DiscriminationTree::remove(const Atom *atom, bool negated, const Entry &entry)
+{
+    std::vector<Key> keys;
+    path(atom, keys);
+
+    Node *node = m_roots[negated].get();
+    for (const Key &key : keys)
+    {
+        node = node->child(key, false);
+        if (!node)
+        {
+            return false;
+        }
+    }
+
+    auto it = std::find(node->entries.begin(), node->entries.end(), entry);
+    if (it == node->entries.end())
+    {
+        return false;
+    }
+    node->entries.erase(it);
+    --m_size;
+    return true;
+}
+
+/**
+ * @brief skipTerm - preskace jedan ceo term u stablu ispod cvora 'node'
+ * @details Za svaki cvor u kome se preskoceni term zavrsava poziva 'visit' sa tim cvorom
+ * i nizom kljuceva preskocenog terma.
+ */
+template <typename Visit>
+static void skipTerm(const Node *node, std::uint32_t remaining, std::vector<Key> &keys, Visit &visit)
+{
+    for (const auto &c : node->children)
+    {
+        const Key &key = c.first;
+        std::uint32_t left = remaining - 1 + (key.isVariable() ? 0 : key.arity);
+        keys.push_back(key);
+        if (left == 0)
+        {
+            visit(c.second.get(), keys);
+        }
+        else
+        {
+            skipTerm(c.second.get(), left, keys, visit);
+        }
+        keys.pop_back();
+    }
+}
+
+static void collect(const Node *node, std::vector<Entry> &out)
+{
+    out.insert(out.end(), node->entries.cbegin(), node->entries.cend());
+}
+
+static void unifiableFrom(const Node *node, const FlatTerm &q, std::uint32_t pos, std::vector<Entry> &out)
+{
+    if (pos == q.size())
+    {
+        collect(node, out);
+        return;
+    }
+
+    const FlatCell &cell = q[pos];
+    if (cell.isVariable())
+    {
+        /* Promenljiva upita se moze vezati za bilo koji term stabla */
+        std::vector<Key> keys;
+        auto visit = [&](const Node *next, const std::vector<Key> &)
+        {
+            unifiableFrom(next, q, pos + 1, out);
+        };
+        skipTerm(node, 1, keys, visit);
+        return;
+    }
+
+    const Key key = keyOf(cell);
+    for (const auto &c : node->children)
+    {
+        if (c.first.isVariable())
+        {
+            /* Promenljiva stabla se moze vezati za ceo podterm upita */
+            unifiableFrom(c.second.get(), q, q.next(pos), out);
+        }
+        else if (c.first == key)
+        {
+            unifiableFrom(c.second.get(), q, pos + 1, out);
+        }
+    }
+}
+
+/**
+ * @brief generalizationsFrom - 'bound' cuva poziciju podterma upita za svaku promenljivu stabla na putu
+ */
+static void generalizationsFrom(const Node *node, const FlatTerm &q, std::uint32_t pos,
+                                std::vector<std::uint32_t> &bound, std::vector<Entry> &out)
+{
+    if (pos == q.size())
+    {
+        collect(node, out);
+        return;
+    }
+
+    const FlatCell &cell = q[pos];
+    for (const auto &c : node->children)
+    {
+        const Key &key = c.first;
+        if (key.isVariable())
+        {
+            if (key.symbol < bound.size())
+            {
+                /* Ponovljena promenljiva stabla mora pokriti jednak podterm upita */
+                if (q.subtermEqual(bound[key.symbol], q, pos))
+                {
+                    generalizationsFrom(c.second.get(), q, q.next(pos), bound, out);
+                }
+            }
+            else
+            {
+                bound.push_back(pos);
+                generalizationsFrom(c.second.get(), q, q.next(pos), bound, out);
+                bound.pop_back();
+            }
+        }
+        else if (!cell.isVariable() && key == keyOf(cell))
+        {
+            generalizationsFrom(c.second.get(), q, pos + 1, bound, out);
+        }
+    }
+}
+
+/**
+ * @brief instancesFrom - 'bound' cuva niz kljuceva terma stabla za svaku promenljivu upita
+ */
+static void instancesFrom(const Node *node, const FlatTerm &q, std::uint32_t pos,
+                          std::vector<std::pair<Variable, std::vector<Key>>> &bound, std::vector<Entry> &out)
+{
+    if (pos == q.size())
+    {
+        collect(node, out);
+        return;
+    }
+
+    const FlatCell &cell = q[pos];
+    if (!cell.isVariable())
+    {
+        const Node *next = node->child(keyOf(cell));
+        if (next)
+        {
+            instancesFrom(next, q, pos + 1, bound, out);
+        }
+        return;
+    }
+
+    auto it = std::find_if(bound.begin(), bound.end(),
+                           [&](const std::pair<Variable, std::vector<Key>> &b) { return b.first == cell.symbol; });
+    std::vector<Key> keys;
+    if (it != bound.end())
+    {
+        /* Ponovljena promenljiva upita mora pokriti isti term stabla; promenljive stabla su
+         * numerisane na celom putu, pa su isti nizovi kljuceva isti termovi */
+        const std::size_t index = static_cast<std::size_t>(it - bound.begin());
+        auto visit = [&](const Node *next, const std::vector<Key> &skipped)
+        {
+            if (skipped == bound[index].second)
+            {
+                instancesFrom(next, q, pos + 1, bound, out);
+            }
+        };
+        skipTerm(node, 1, keys, visit);
+    }
+    else
+    {
+        auto visit = [&](const Node *next, const std::vector<Key> &skipped)
+        {
+            bound.emplace_back(cell.symbol, skipped);
+            instancesFrom(next, q, pos + 1, bound, out);
+            bound.pop_back();
+        };
+        skipTerm(node, 1, keys, visit);
+    }
+}
+
+void DiscriminationTree::unifiable(const Atom *atom, bool negated, std::vector<Entry> &out) const
+{
+    FlatTerm q = flatten(atom);
+    unifiableFrom(m_roots[negated].get(), q, 0, out);
+}
+
+void DiscriminationTree::generalizations(const Atom *atom, bool negated, std::vector<Entry> &out) const
+{
+    FlatTerm q = flatten(atom);
+    std::vector<std::uint32_t> bound;
+    generalizationsFrom(m_roots[negated].get(), q, 0, bound, out);
+}
+
+void DiscriminationTree::instances(const Atom *atom, bool negated, std::vector<Entry> &out) const
+{
+    FlatTerm q = flatten(atom);
+    std::vector<std::pair<Variable, std::vector<Key>>> bound;
+    instancesFrom(m_roots[negated].get(), q, 0, bound, out);
+}
@@ -0,0 +1,110 @@
+#ifndef DISCRIMINATIONTREE_H
+#define DISCRIMINATIONTREE_H
+
+#include "base_formula.h"
+#include "flat_term.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Atom;
+
+/**
+ * @brief DiscriminationTree - savrseno diskriminaciono stablo nad literalima klauza
+ *
+ * @details Atom literala se zapisuje kao niz kljuceva u prefiksnom poretku (relacijski simbol,
+ * pa simboli argumenata), i taj niz je put od korena do lista u kome se cuva ulaz literala.
+ * Stablo je "savrseno": promenljive se ne stapaju u jedan dzoker, vec se numerisu redom prvog
+ * pojavljivanja, pa p(x, x) i p(x, y) imaju razlicite puteve. Za svaki znak literala postoji
+ * zaseban koren, pa se komplementarni literali traze samo u jednom podstablu.
+ *
+ * Pretraga uopstenja i instanci je tacna. Pretraga unifikabilnih literala je filter: vraca
+ * sve literale unifikabilne sa upitom, ali i poneki koji nisu (ne proverava ponovljene
+ * promenljive), pa je pozivalac duzan da ih zaista unifikuje.
+ */
+class DiscriminationTree
+{
+public:
+    /**
+     * @brief Entry - ulaz indeksa: klauza i pozicija literala u njoj
+     */
+    struct Entry
+    {
+        std::uint32_t clause;
+        std::uint32_t literal;
+
+        inline bool operator==(const Entry &oth) const { return clause == oth.clause && literal == oth.literal; }
+    };
+
+    DiscriminationTree();
+
+    ~DiscriminationTree();
+
+    DiscriminationTree(const DiscriminationTree &) = delete;
+
+    DiscriminationTree& operator=(const DiscriminationTree &) = delete;
+
+    /**
+     * @brief insert - dodaje literal znaka 'negated' sa atomom 'atom' u indeks
+     */
+    void insert(const Atom *atom, bool negated, const Entry &entry);
+
+    /**
+     * @brief remove - izbacuje ulaz literala iz indeksa
+     * @return true ako je ulaz postojao, false inace
+     */
+    bool remove(const Atom *atom, bool negated, const Entry &entry);
+
+    /**
+     * @brief unifiable - literali znaka 'negated' ciji atomi mogu biti unifikabilni sa atomom 'atom'
+     */
+    void unifiable(const Atom *atom, bool negated, std::vector<Entry> &out) const;
+
+    /**
+     * @brief generalizations - literali znaka 'negated' ciji se atomi uparuju sa atomom 'atom' (l -> atom)
+     */
+    void generalizations(const Atom *atom, bool negated, std::vector<Entry> &out) const;
+
+    /**
+     * @brief instances - literali znaka 'negated' ciji su atomi instance atoma 'atom' (atom -> l)
+     */
+    void instances(const Atom *atom, bool negated, std::vector<Entry> &out) const;
+
+    inline std::size_t size() const { return m_size; }
+
+    void clear();
+
+    /**
+     * @brief Key - jedan kljuc puta: simbol i arnost, ili redni broj promenljive
+     */
+    struct Key
+    {
+        std::uint32_t symbol;
+        std::uint32_t arity;
+
+        inline bool isVariable() const { return arity == FlatCell::VariableArity; }
+
+        inline bool operator==(const Key &oth) const { return symbol == oth.symbol && arity == oth.arity; }
+
+        inline bool operator!=(const Key &oth) const { return !(*this == oth); }
+    };
+
+    struct Node;
+
+private:
+    /**
+     * @brief path - niz kljuceva atoma literala
+     */
+    static void path(const Atom *atom, std::vector<Key> &keys);
+
+    std::unique_ptr<Node> m_roots[2];
+    std::size_t m_size = 0;
+};
+
+/**
+ * @brief flatten - ravan zapis atoma: relacijski simbol kao koren, pa argumenti
+ */
+FlatTerm flatten(const Atom *atom);
+
+#endif // DISCRIMINATIONTREE_H
@@ -5,18 +5,13 @@
 #include <iterator>
 
 Exists::Exists(const Variable &var, const Formula &f)
-    : Quantifier (var, f)
+    : Quantifier (Kind::Exists, var, f)
 {
 }
 
-Formula Exists::substitute(const Variable &v, const Term &t) const
+Exists::Exists(const Variable &var, const Formula &body, LocallyNameless tag)
+    : Quantifier (Kind::Exists, var, body, tag)
 {
-    return substituteImpl<Exists>(v, t);
-}
-
-Formula Exists::substitute(const Substitution &s) const
-{
-    return substituteImpl<Exists>(s);
 }
 
 std::ostream &Exists::print(std::ostream &out) const
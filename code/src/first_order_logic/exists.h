@@ -8,9 +8,9 @@ class Exists : public Quantifier
 public:
     Exists(const Variable &var, const Formula &f);
     
-    virtual Formula substitute(const Variable & v, const Term & t) const;
+    Exists(const Variable &var, const Formula &body, LocallyNameless tag);
     
-    virtual Formula substitute(const Substitution &s) const;
+    static inline bool isKind(Kind kind) { return kind == Kind::Exists; }
     
     virtual std::ostream& print(std::ostream & out) const;
 };
@@ -0,0 +1,107 @@
+#include "factory.h"
+
+Factory::Table<BaseTerm>& Factory::terms()
+{
+    /* Tabela se namerno nikad ne unistava jer cvorovi mogu da nadzive staticke objekte */
+    static Table<BaseTerm> *s_terms = new Table<BaseTerm>();
+    return *s_terms;
+}
+
+Factory::Table<BaseFormula>& Factory::formulas()
+{
+    static Table<BaseFormula> *s_formulas = new Table<BaseFormula>();
+    return *s_formulas;
+}
+
+template <typename Node>
+Node* Factory::findIn(const Table<Node> &table, const Node &candidate)
+{
+    auto range = table.equal_range(candidate.hash());
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second->shallowEqualTo(candidate))
+        {
+            return it->second;
+        }
+    }
+    return nullptr;
+}
+
+template <typename Node>
+void Factory::eraseFrom(Table<Node> &table, const Node *node)
+{
+    /* Brisemo bas ovaj cvor, ne neki njemu jednak */
+    auto range = table.equal_range(node->hash());
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second == node)
+        {
+            table.erase(it);
+            return;
+        }
+    }
+}
+
+BaseTerm* Factory::find(const BaseTerm &candidate)
+{
+    return findIn(terms(), candidate);
+}
+
+BaseFormula* Factory::find(const BaseFormula &candidate)
+{
+    return findIn(formulas(), candidate);
+}
+
+void Factory::insert(BaseTerm *t, Region *region, std::size_t size)
+{
+    if (region)
+    {
+        region->addRef();
+        t->m_region = region;
+        t->m_allocSize = static_cast<std::uint32_t>(size);
+    }
+    t->m_interned = true;
+    terms().emplace(t->hash(), t);
+}
+
+void Factory::insert(BaseFormula *f, Region *region, std::size_t size)
+{
+    if (region)
+    {
+        region->addRef();
+        f->m_region = region;
+        f->m_allocSize = static_cast<std::uint32_t>(size);
+    }
+    f->m_interned = true;
+    formulas().emplace(f->hash(), f);
+}
+
+void Factory::initHash(BaseTerm &t, std::size_t seed)
+{
+    t.m_hash = hashCombine(seed, t.shallowHash());
+}
+
+void Factory::initHash(BaseFormula &f, std::size_t seed)
+{
+    f.m_hash = hashCombine(seed, f.shallowHash());
+}
+
+void Factory::release(const BaseTerm *t)
+{
+    eraseFrom(terms(), t);
+}
+
+void Factory::release(const BaseFormula *f)
+{
+    eraseFrom(formulas(), f);
+}
+
+std::size_t Factory::termCount()
+{
+    return terms().size();
+}
+
+std::size_t Factory::formulaCount()
+{
+    return formulas().size();
+}
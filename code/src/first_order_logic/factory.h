@@ -0,0 +1,104 @@
+#ifndef FACTORY_H
+#define FACTORY_H
+
+#include "base_term.h"
+#include "base_formula.h"
+#include "region.h"
+
+#include <new>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @brief Factory - pravi (interning) sve cvorove termova i formula
+ *
+ * @details Strukturno jednaki termovi i formule se predstavljaju jednim istim
+ * deljenim cvorom (hash-consing). Zbog toga se sintaksna jednakost svodi na
+ * poredjenje pokazivaca, a izmenjene kopije dobijene supstitucijom ponovo koriste
+ * vec postojece podtermove i potformule. Tabele cuvaju samo sirove pokazivace,
+ * a cvor se sam izbacuje iz tabele kada se unisti.
+ *
+ * Svi termovi i formule moraju da se prave preko Factory::make, inace
+ * poredjenje pokazivacem nije ispravno. Ako je aktivan Region, novi cvorovi
+ * se alociraju iz njega.
+ */
+class Factory
+{
+public:
+    /**
+     * @brief make - vraca jedinstveni cvor tipa T sa zadatim argumentima konstruktora
+     * @param args - argumenti konstruktora
+     * @return postojeci strukturno jednak cvor ako postoji, inace novi cvor
+     */
+    template <typename T, typename... Args>
+    static Ref<T> make(Args&&... args);
+
+    /**
+     * @brief release - izbacuje cvor iz tabele, poziva se iz destruktora cvora
+     */
+    static void release(const BaseTerm *t);
+
+    static void release(const BaseFormula *f);
+
+    /**
+     * @brief termCount - broj zivih jedinstvenih termova
+     */
+    static std::size_t termCount();
+
+    /**
+     * @brief formulaCount - broj zivih jedinstvenih formula
+     */
+    static std::size_t formulaCount();
+
+private:
+    template <typename Node>
+    using Table = std::unordered_multimap<std::size_t, Node*>;
+
+    static Table<BaseTerm>& terms();
+
+    static Table<BaseFormula>& formulas();
+
+    template <typename Node>
+    static Node* findIn(const Table<Node> &table, const Node &candidate);
+
+    template <typename Node>
+    static void eraseFrom(Table<Node> &table, const Node *node);
+
+    static BaseTerm* find(const BaseTerm &candidate);
+
+    static BaseFormula* find(const BaseFormula &candidate);
+
+    /**
+     * @brief insert - ubacuje novi cvor u tabelu i pamti region iz kog je alociran (ili nullptr)
+     */
+    static void insert(BaseTerm *t, Region *region, std::size_t size);
+
+    static void insert(BaseFormula *f, Region *region, std::size_t size);
+
+    static void initHash(BaseTerm &t, std::size_t seed);
+
+    static void initHash(BaseFormula &f, std::size_t seed);
+};
+
+template <typename T, typename... Args>
+Ref<T> Factory::make(Args&&... args)
+{
+    /* Kandidat se pravi na steku, pa se u slucaju pogotka ne alocira nista */
+    T candidate(std::forward<Args>(args)...);
+    initHash(candidate, static_cast<std::size_t>(candidate.kind()));
+
+    auto existing = find(candidate);
+    if (existing)
+    {
+        return Ref<T>(static_cast<T*>(existing));
+    }
+
+    Region *region = Region::current().get();
+    T *node = region
+            ? new (region->allocate(sizeof(T), alignof(T))) T(std::move(candidate))
+            : new T(std::move(candidate));
+    insert(node, region, sizeof(T));
+    return Ref<T>(node);
+}
+
+#endif // FACTORY_H
@@ -0,0 +1,156 @@
+#include "feature_vector_index.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <utility>
+
+void FeatureVector::addLiteral(const RelationSymbol &symbol, bool negated, unsigned depth)
+{
+    std::size_t group = (negated ? Groups : 0) + symbol.id() % Groups;
+    std::uint32_t &count = m_values[1 + group];
+    std::uint32_t &maxDepth = m_values[1 + 2 * Groups + group];
+    ++m_values[0];
+    ++count;
+    maxDepth = std::max<std::uint32_t>(maxDepth, depth);
+}
+
+bool FeatureVector::lessOrEqual(const FeatureVector &oth) const
+{
+    for (std::size_t i = 0; i < Size; ++i)
+    {
+        if (m_values[i] > oth.m_values[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+struct FeatureVectorIndex::Node
+{
+    /* Deca su uredjena rastuce po vrednosti osobine */
+    std::vector<std::pair<std::uint32_t, std::unique_ptr<Node>>> children;
+    std::vector<std::uint32_t> clauses;
+
+    using Child = std::pair<std::uint32_t, std::unique_ptr<Node>>;
+
+    std::vector<Child>::iterator lowerBound(std::uint32_t value)
+    {
+        return std::lower_bound(children.begin(), children.end(), value,
+                                [](const Child &c, std::uint32_t v) { return c.first < v; });
+    }
+
+    std::vector<Child>::const_iterator lowerBound(std::uint32_t value) const
+    {
+        return std::lower_bound(children.cbegin(), children.cend(), value,
+                                [](const Child &c, std::uint32_t v) { return c.first < v; });
+    }
+};
+
+using Node = FeatureVectorIndex::Node;
+
+FeatureVectorIndex::FeatureVectorIndex()
+    : m_root(new Node())
+{
+}
+
+FeatureVectorIndex::~FeatureVectorIndex() = default;
+
+void FeatureVectorIndex::clear()
+{
+    m_root.reset(new Node());
+    m_size = 0;
+}
+
+void FeatureVectorIndex::insert(const FeatureVector &features, std::uint32_t clause)
+{
+    Node *node = m_root.get();
+    for (std::size_t i = 0; i < FeatureVector::Size; ++i)
+    {
+        auto it = node->lowerBound(features[i]);
+        if (it == node->children.end() || it->first != features[i])
+        {
+            it = node->children.emplace(it, features[i], std::unique_ptr<Node>(new Node()));
+        }
+        node = it->second.get();
+    }
+    node->clauses.push_back(clause);
+    ++m_size;
+}
+
+bool FeatureVectorIndex::remove(const FeatureVector &features, std::uint32_t clause)
+{
+    /* Put od korena: roditelj na svakom nivou i pozicija deteta u njegovom nizu */
+    std::array<std::pair<Node*, std::size_t>, FeatureVector::Size> path;
+    Node *node = m_root.get();
+    for (std::size_t i = 0; i < FeatureVector::Size; ++i)
+    {
+        auto it = node->lowerBound(features[i]);
+        if (it == node->children.end() || it->first != features[i])
+        {
+            return false;
+        }
+        path[i] = {node, static_cast<std::size_t>(it - node->children.begin())};
+        node = it->second.get();
+    }
+
+    auto it = std::find(node->clauses.begin(), node->clauses.end(), clause);
+    if (it == node->clauses.end())
+    {
+        return false;
+    }
+    node->clauses.erase(it);
+    --m_size;
+
+    /* Cvorovi bez klauza i dece se uklanjaju odozdo, da upiti ne bi obilazili prazne grane */
+    for (std::size_t i = FeatureVector::Size; i-- > 0 && node->clauses.empty() && node->children.empty(); )
+    {
+        Node *parent = path[i].first;
+        parent->children.erase(parent->children.begin() + static_cast<std::ptrdiff_t>(path[i].second));
+        node = parent;
+    }
+    return true;
+}
+
+static void collectLessOrEqual(const Node *node, std::size_t level, const FeatureVector &features, std::vector<std::uint32_t> &out)
+{
+    if (level == FeatureVector::Size)
+    {
+        out.insert(out.end(), node->clauses.cbegin(), node->clauses.cend());
+        return;
+    }
+
+    for (const auto &c : node->children)
+    {
+        if (c.first > features[level])
+        {
+            break;
+        }
+        collectLessOrEqual(c.second.get(), level + 1, features, out);
+    }
+}
+
+static void collectGreaterOrEqual(const Node *node, std::size_t level, const FeatureVector &features, std::vector<std::uint32_t> &out)
+{
+    if (level == FeatureVector::Size)
+    {
+        out.insert(out.end(), node->clauses.cbegin(), node->clauses.cend());
+        return;
+    }
+
+    for (auto it = node->lowerBound(features[level]); it != node->children.cend(); ++it)
+    {
+        collectGreaterOrEqual(it->second.get(), level + 1, features, out);
+    }
+}
+
+void FeatureVectorIndex::subsuming(const FeatureVector &features, std::vector<std::uint32_t> &out) const
+{
+    collectLessOrEqual(m_root.get(), 0, features, out);
+}
+
+void FeatureVectorIndex::subsumed(const FeatureVector &features, std::vector<std::uint32_t> &out) const
+{
+    collectGreaterOrEqual(m_root.get(), 0, features, out);
+}
@@ -0,0 +1,99 @@
+#ifndef FEATUREVECTORINDEX_H
+#define FEATUREVECTORINDEX_H
+
+#include "common.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief FeatureVector - vektor osobina klauze za filtriranje kandidata za sadrzanost
+ *
+ * @details Osobine su broj razlicitih literala klauze, a za svaki znak i svaku grupu
+ * relacijskih simbola (simbol se rasporedjuje u grupu po svom id-ju) broj razlicitih
+ * literala i najveca dubina argumenata. Ako klauza C sadrzi (subsumira) klauzu D, onda
+ * je svaka osobina klauze C manja ili jednaka odgovarajucoj osobini klauze D: razliciti
+ * literali C se slikaju u razlicite literale D istog znaka i simbola, a instanca terma
+ * nije plica od samog terma. Obrnuto ne vazi, pa je vektor samo filter.
+ */
+class FeatureVector
+{
+public:
+    /**
+     * @brief Groups - broj grupa relacijskih simbola po znaku
+     */
+    static constexpr std::size_t Groups = 4;
+
+    static constexpr std::size_t Size = 1 + 4 * Groups;
+
+    /**
+     * @brief addLiteral - dodaje jedan literal klauze, isti literal se ne sme dodati dva puta
+     * @param symbol - relacijski simbol atoma literala
+     * @param negated - da li je literal negacija atoma
+     * @param depth - najveca dubina argumenata atoma
+     */
+    void addLiteral(const RelationSymbol &symbol, bool negated, unsigned depth);
+
+    inline std::uint32_t operator[](std::size_t i) const { return m_values[i]; }
+
+    /**
+     * @brief lessOrEqual - da li je svaka osobina tekuceg vektora manja ili jednaka osobini 'oth'
+     */
+    bool lessOrEqual(const FeatureVector &oth) const;
+
+private:
+    std::array<std::uint32_t, Size> m_values{};
+};
+
+/**
+ * @brief FeatureVectorIndex - indeks klauza po vektorima osobina (u stilu Schulz-a)
+ *
+ * @details Vektori su smesteni u stablo prefiksa u kome nivo i odgovara i-toj osobini, a
+ * deca cvora su uredjena po vrednosti osobine. Upit za klauze koje mogu da sadrze datu
+ * klauzu obilazi samo decu sa vrednoscu manjom ili jednakom osobini upita, a upit za klauze
+ * koje data klauza moze da sadrzi samo decu sa vecom ili jednakom vrednoscu. Vraceni
+ * kandidati se moraju proveriti pravom proverom sadrzanosti.
+ */
+class FeatureVectorIndex
+{
+public:
+    FeatureVectorIndex();
+
+    ~FeatureVectorIndex();
+
+    FeatureVectorIndex(const FeatureVectorIndex &) = delete;
+
+    FeatureVectorIndex& operator=(const FeatureVectorIndex &) = delete;
+
+    void insert(const FeatureVector &features, std::uint32_t clause);
+
+    /**
+     * @brief remove - izbacuje klauzu sa zadatim vektorom osobina
+     * @return true ako je klauza bila u indeksu, false inace
+     */
+    bool remove(const FeatureVector &features, std::uint32_t clause);
+
+    /**
+     * @brief subsuming - kandidati za klauze koje sadrze klauzu sa osobinama 'features' (unapred)
+     */
+    void subsuming(const FeatureVector &features, std::vector<std::uint32_t> &out) const;
+
+    /**
+     * @brief subsumed - kandidati za klauze koje klauza sa osobinama 'features' sadrzi (unazad)
+     */
+    void subsumed(const FeatureVector &features, std::vector<std::uint32_t> &out) const;
+
+    inline std::size_t size() const { return m_size; }
+
+    void clear();
+
+    struct Node;
+
+private:
+    std::unique_ptr<Node> m_root;
+    std::size_t m_size = 0;
+};
+
+#endif // FEATUREVECTORINDEX_H
@@ -3,6 +3,7 @@
 
 #include "variable_term.h"
 #include "function_term.h"
+#include "bound_variable_term.h"
 
 #include "atom.h"
 #include "not.h"
@@ -0,0 +1,362 @@
+#include "flat_term.h"
+#include "factory.h"
+#include "function_term.h"
+#include "variable_term.h"
+
+#include <cstring>
+
+FlatTerm::FlatTerm(const Term &t)
+{
+    m_cells.reserve(t->size());
+    append(t.get());
+}
+
+Term FlatTerm::toTerm() const
+{
+    return toTerm(0);
+}
+
+Term FlatTerm::toTerm(std::uint32_t pos) const
+{
+    const FlatCell &cell = m_cells[pos];
+    if (cell.isVariable())
+    {
+        return Factory::make<VariableTerm>(cell.symbol);
+    }
+
+    std::vector<Term> operands;
+    operands.reserve(cell.arity);
+    std::uint32_t child = pos + 1;
+    for (std::uint32_t i = 0; i < cell.arity; ++i)
+    {
+        operands.push_back(toTerm(child));
+        child = next(child);
+    }
+    return Factory::make<FunctionTerm>(cell.symbol, operands);
+}
+
+bool FlatTerm::subtermEqual(std::uint32_t pos, const FlatTerm &oth, std::uint32_t othPos) const
+{
+    /* 'skip' vrednosti su relativne, pa su jednaki podtermovi i bajt po bajt jednaki nizovi celija */
+    std::uint32_t skip = m_cells[pos].skip;
+    return skip == oth.m_cells[othPos].skip &&
+           std::memcmp(m_cells.data() + pos, oth.m_cells.data() + othPos, skip * sizeof(FlatCell)) == 0;
+}
+
+bool FlatTerm::equalTo(const FlatTerm &oth) const
+{
+    if (size() != oth.size())
+    {
+        return false;
+    }
+    return size() == 0 || subtermEqual(0, oth, 0);
+}
+
+bool FlatTerm::hasVariable(const Variable &v, std::uint32_t pos) const
+{
+    for (std::uint32_t i = pos, last = next(pos); i < last; ++i)
+    {
+        if (m_cells[i].isVariable() && m_cells[i].symbol == v)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void substituteInto(FlatTerm &out, const FlatTerm &t, std::uint32_t pos, const Substitution &s)
+{
+    const FlatCell &cell = t[pos];
+    if (cell.isVariable())
+    {
+        auto it = s.find(cell.symbol);
+        if (it != s.cend())
+        {
+            out.append(it->second.get());
+        }
+        else
+        {
+            out.appendSymbol(cell.symbol, FlatCell::VariableArity);
+        }
+        return;
+    }
+
+    std::uint32_t outPos = out.appendSymbol(cell.symbol, cell.arity);
+    std::uint32_t child = pos + 1;
+    for (std::uint32_t i = 0; i < cell.arity; ++i)
+    {
+        substituteInto(out, t, child, s);
+        child = t.next(child);
+    }
+    out.close(outPos);
+}
+
+FlatTerm FlatTerm::substitute(const Substitution &s) const
+{
+    if (s.empty() || m_cells.empty())
+    {
+        return *this;
+    }
+    FlatTerm result;
+    substituteInto(result, *this, 0, s);
+    return result;
+}
+
+void FlatTerm::append(const BaseTerm *t)
+{
+    if (t->kind() == BaseTerm::Kind::Variable)
+    {
+        appendSymbol(static_cast<const VariableTerm*>(t)->variable(), FlatCell::VariableArity);
+        return;
+    }
+
+    const FunctionTerm *ft = static_cast<const FunctionTerm*>(t);
+    std::uint32_t pos = appendSymbol(ft->symbol(), static_cast<std::uint32_t>(ft->operands().size()));
+    for (const Term &op : ft->operands())
+    {
+        append(op.get());
+    }
+    close(pos);
+}
+
+void FlatTerm::append(const FlatTerm &oth, std::uint32_t pos)
+{
+    std::uint32_t skip = oth.m_cells[pos].skip;
+    std::size_t first = m_cells.size();
+    m_cells.resize(first + skip);
+    std::memcpy(static_cast<void*>(m_cells.data() + first), oth.m_cells.data() + pos, skip * sizeof(FlatCell));
+}
+
+std::uint32_t FlatTerm::appendSymbol(const Symbol &symbol, std::uint32_t arity)
+{
+    std::uint32_t pos = static_cast<std::uint32_t>(m_cells.size());
+    m_cells.push_back(FlatCell{symbol, arity, 1});
+    return pos;
+}
+
+std::ostream& FlatTerm::print(std::ostream &out, std::uint32_t pos) const
+{
+    const FlatCell &cell = m_cells[pos];
+    out << cell.symbol;
+    if (cell.isVariable() || cell.arity == 0)
+    {
+        return out;
+    }
+
+    out << "(";
+    std::uint32_t child = pos + 1;
+    for (std::uint32_t i = 0; i < cell.arity; ++i)
+    {
+        if (i != 0)
+        {
+            out << ", ";
+        }
+        print(out, child);
+        child = next(child);
+    }
+    return out << ")";
+}
+
+const FlatRef* FlatBindings::find(const Variable &v) const
+{
+    for (const auto &binding : m_bindings)
+    {
+        if (binding.first == v)
+        {
+            return &binding.second;
+        }
+    }
+    return nullptr;
+}
+
+void FlatBindings::bind(const Variable &v, const FlatRef &ref)
+{
+    m_bindings.emplace_back(v, ref);
+}
+
+FlatRef FlatBindings::deref(FlatRef ref) const
+{
+    if (m_oneWay)
+    {
+        return ref;
+    }
+    while (ref.cell().isVariable())
+    {
+        const FlatRef *bound = find(ref.cell().symbol);
+        if (!bound)
+        {
+            break;
+        }
+        ref = *bound;
+    }
+    return ref;
+}
+
+void FlatBindings::resolveInto(FlatTerm &out, const FlatRef &ref) const
+{
+    FlatRef r = deref(ref);
+    const FlatCell &cell = r.cell();
+    if (cell.isVariable())
+    {
+        out.appendSymbol(cell.symbol, FlatCell::VariableArity);
+        return;
+    }
+
+    std::uint32_t outPos = out.appendSymbol(cell.symbol, cell.arity);
+    std::uint32_t child = r.pos + 1;
+    for (std::uint32_t i = 0; i < cell.arity; ++i)
+    {
+        resolveInto(out, FlatRef{r.term, child});
+        child = r.term->next(child);
+    }
+    out.close(outPos);
+}
+
+FlatTerm FlatBindings::resolve(const FlatRef &ref) const
+{
+    FlatTerm result;
+    if (m_oneWay)
+    {
+        result.append(*ref.term, ref.pos);
+    }
+    else
+    {
+        resolveInto(result, ref);
+    }
+    return result;
+}
+
+Substitution FlatBindings::toSubstitution() const
+{
+    Substitution s;
+    for (const auto &binding : m_bindings)
+    {
+        s[binding.first] = resolve(binding.second).toTerm();
+    }
+    return s;
+}
+
+/**
+ * @brief occurs - provera pojavljivanja promenljive u podtermu pod tekucim vezivanjima
+ */
+static bool occurs(const Variable &v, const FlatRef &ref, const FlatBindings &bindings)
+{
+    const FlatTerm &t = *ref.term;
+    for (std::uint32_t i = ref.pos, last = t.next(ref.pos); i < last; ++i)
+    {
+        if (!t[i].isVariable())
+        {
+            continue;
+        }
+        if (t[i].symbol == v)
+        {
+            return true;
+        }
+        const FlatRef *bound = bindings.find(t[i].symbol);
+        if (bound && occurs(v, *bound, bindings))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool unify(const FlatTerm &t1, const FlatTerm &t2, FlatBindings &bindings)
+{
+    /* Promenljive oba terma se vezuju, pa se vezivanja, i ranija, citaju uz pracenje */
+    bindings.m_oneWay = false;
+
+    std::vector<std::pair<FlatRef, FlatRef>> stack;
+    stack.emplace_back(FlatRef{&t1, 0}, FlatRef{&t2, 0});
+
+    while (!stack.empty())
+    {
+        FlatRef l = bindings.deref(stack.back().first);
+        FlatRef r = bindings.deref(stack.back().second);
+        stack.pop_back();
+
+        const FlatCell &lc = l.cell();
+        const FlatCell &rc = r.cell();
+        if (lc.isVariable())
+        {
+            if (rc.isVariable() && rc.symbol == lc.symbol)
+            {
+                continue;
+            }
+            if (occurs(lc.symbol, r, bindings))
+            {
+                return false;
+            }
+            bindings.bind(lc.symbol, r);
+        }
+        else if (rc.isVariable())
+        {
+            if (occurs(rc.symbol, l, bindings))
+            {
+                return false;
+            }
+            bindings.bind(rc.symbol, l);
+        }
+        else if (lc.symbol != rc.symbol || lc.arity != rc.arity)
+        {
+            return false;
+        }
+        else if (!l.term->subtermEqual(l.pos, *r.term, r.pos))
+        {
+            /* Jednaki podtermovi se unifikuju bez vezivanja, pa se ne obilaze */
+            std::uint32_t lchild = l.pos + 1;
+            std::uint32_t rchild = r.pos + 1;
+            for (std::uint32_t i = 0; i < lc.arity; ++i)
+            {
+                stack.emplace_back(FlatRef{l.term, lchild}, FlatRef{r.term, rchild});
+                lchild = l.term->next(lchild);
+                rchild = r.term->next(rchild);
+            }
+        }
+    }
+    return true;
+}
+
+bool match(const FlatTerm &pattern, const FlatTerm &target, FlatBindings &bindings)
+{
+    bindings.m_oneWay = true;
+
+    /* Oba terma se obilaze istovremeno u prefiksnom poretku, promenljiva obrasca preskace ceo podterm cilja */
+    std::uint32_t i = 0, j = 0;
+    while (i < pattern.size())
+    {
+        const FlatCell &pc = pattern[i];
+        if (pc.isVariable())
+        {
+            const FlatRef *bound = bindings.find(pc.symbol);
+            if (bound)
+            {
+                if (!bound->term->subtermEqual(bound->pos, target, j))
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                bindings.bind(pc.symbol, FlatRef{&target, j});
+            }
+            ++i;
+            j = target.next(j);
+            continue;
+        }
+
+        const FlatCell &tc = target[j];
+        if (tc.isVariable() || pc.symbol != tc.symbol || pc.arity != tc.arity)
+        {
+            return false;
+        }
+        ++i;
+        ++j;
+    }
+    return true;
+}
+
+std::ostream& operator<<(std::ostream &out, const FlatTerm &t)
+{
+    return t.print(out);
+}
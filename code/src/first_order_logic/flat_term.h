@@ -0,0 +1,201 @@
+#ifndef FLATTERM_H
+#define FLATTERM_H
+
+#include "common.h"
+#include "base_term.h"
+#include "small_vector.h"
+
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief FlatCell - jedan simbol ravnog terma
+ *
+ * @details Polja su sva 32-bitna i nema poravnanja izmedju njih, pa se dva niza celija
+ * mogu porediti sa memcmp. Polje 'skip' je broj celija podterma koji pocinje ovom
+ * celijom, pa je sledeci brat podterma na poziciji i + skip.
+ */
+struct FlatCell
+{
+    /**
+     * @brief VariableArity - arnost kojom se oznacava celija promenljive
+     */
+    static constexpr std::uint32_t VariableArity = 0xFFFFFFFFu;
+
+    Symbol symbol;
+    std::uint32_t arity;
+    std::uint32_t skip;
+
+    inline bool isVariable() const { return arity == VariableArity; }
+};
+
+/**
+ * @brief FlatTerm - term zapisan kao niz celija u prefiksnom poretku
+ *
+ * @details Ceo term je u jednom neprekidnom nizu, pa obilazak ne skace po hipu kao kod
+ * stabla deljenih cvorova. Mali termovi (do InlineCells simbola) se cuvaju u samom objektu.
+ * Podterm je opisan pozicijom svoje prve celije, a zauzima narednih 'skip' celija.
+ */
+class FlatTerm
+{
+public:
+    static constexpr std::size_t InlineCells = 8;
+
+    using Cells = SmallVector<FlatCell, InlineCells>;
+
+    FlatTerm() = default;
+
+    /**
+     * @brief FlatTerm - pravi ravan zapis terma
+     * @details Term mora biti lokalno zatvoren, tj. bez vezanih promenljivih (looseBound() == 0).
+     */
+    explicit FlatTerm(const Term &t);
+
+    /**
+     * @brief toTerm - vraca term kao stablo cvorova napravljenih preko Factory-ja
+     */
+    Term toTerm() const;
+
+    inline std::size_t size() const { return m_cells.size(); }
+
+    inline const FlatCell& operator[](std::size_t pos) const { return m_cells[pos]; }
+
+    inline const FlatCell* cells() const { return m_cells.data(); }
+
+    /**
+     * @brief next - pozicija prve celije posle podterma koji pocinje na poziciji 'pos'
+     */
+    inline std::uint32_t next(std::uint32_t pos) const { return pos + m_cells[pos].skip; }
+
+    /**
+     * @brief subtermEqual - poredi podterm na poziciji 'pos' sa podtermom 'oth' na poziciji 'othPos'
+     */
+    bool subtermEqual(std::uint32_t pos, const FlatTerm &oth, std::uint32_t othPos) const;
+
+    bool equalTo(const FlatTerm &oth) const;
+
+    /**
+     * @brief hasVariable - provera da li podterm na poziciji 'pos' sadrzi promenljivu
+     */
+    bool hasVariable(const Variable &v, std::uint32_t pos = 0) const;
+
+    /**
+     * @brief substitute - primenjuje supstituciju direktno na ravan zapis
+     */
+    FlatTerm substitute(const Substitution &s) const;
+
+    /**
+     * @brief append - dodaje na kraj niza celija ravan zapis terma 't'
+     */
+    void append(const BaseTerm *t);
+
+    /**
+     * @brief append - dodaje na kraj niza celija podterm terma 'oth' koji pocinje na poziciji 'pos'
+     */
+    void append(const FlatTerm &oth, std::uint32_t pos);
+
+    /**
+     * @brief appendSymbol - zapocinje novi podterm simbolom, 'skip' funkcijskog simbola se popunjava sa close()
+     * @return pozicija celije simbola
+     */
+    std::uint32_t appendSymbol(const Symbol &symbol, std::uint32_t arity);
+
+    /**
+     * @brief close - zatvara podterm zapocet na poziciji 'pos' (racuna njegov 'skip')
+     */
+    inline void close(std::uint32_t pos) { m_cells[pos].skip = static_cast<std::uint32_t>(m_cells.size()) - pos; }
+
+    std::ostream& print(std::ostream &out, std::uint32_t pos = 0) const;
+
+private:
+    Term toTerm(std::uint32_t pos) const;
+
+    Cells m_cells;
+};
+
+/**
+ * @brief FlatRef - pokazivac na podterm ravnog terma
+ */
+struct FlatRef
+{
+    const FlatTerm *term;
+    std::uint32_t pos;
+
+    inline const FlatCell& cell() const { return (*term)[pos]; }
+};
+
+/**
+ * @brief FlatBindings - trougaona supstitucija nad ravnim termovima
+ *
+ * @details Promenljiva se vezuje za podterm jednog od ulaznih ravnih termova, bez kopiranja.
+ * Vrednost vezanog podterma moze da sadrzi druge vezane promenljive, pa se pri citanju
+ * vezivanja prate sve dok se ne stigne do slobodne promenljive ili funkcijskog simbola.
+ * Ulazni termovi moraju da zive dok se koristi supstitucija.
+ *
+ * Vezivanja dobijena jednosmernim uparivanjem (match) pokazuju na podtermove cilja cije se
+ * promenljive ne vezuju, pa se ona citaju bez pracenja vezivanja. Nacin citanja odredjuje
+ * poslednji poziv: unify ga vraca na pracenje vezivanja, pa se dopunjena vezivanja citaju
+ * kao obicna trougaona supstitucija.
+ */
+class FlatBindings
+{
+    friend bool unify(const FlatTerm &t1, const FlatTerm &t2, FlatBindings &bindings);
+
+    friend bool match(const FlatTerm &pattern, const FlatTerm &target, FlatBindings &bindings);
+
+public:
+    /**
+     * @brief find - vezivanje promenljive, nullptr ako promenljiva nije vezana
+     */
+    const FlatRef* find(const Variable &v) const;
+
+    void bind(const Variable &v, const FlatRef &ref);
+
+    /**
+     * @brief deref - prati vezivanja promenljivih dok se ne stigne do nevezanog podterma
+     */
+    FlatRef deref(FlatRef ref) const;
+
+    /**
+     * @brief resolve - ravan zapis podterma na koji su primenjena sva vezivanja
+     */
+    FlatTerm resolve(const FlatRef &ref) const;
+
+    /**
+     * @brief toSubstitution - prevodi vezivanja u obicnu (idempotentnu) supstituciju
+     */
+    Substitution toSubstitution() const;
+
+    inline std::size_t size() const { return m_bindings.size(); }
+
+    inline void clear() { m_bindings.clear(); m_oneWay = false; }
+
+private:
+    void resolveInto(FlatTerm &out, const FlatRef &ref) const;
+
+    /* Vezivanja ima malo, pa je linearna pretraga niza brza od mape */
+    std::vector<std::pair<Variable, FlatRef>> m_bindings;
+    bool m_oneWay = false;
+};
+
+/**
+ * @brief unify - unifikuje dva ravna terma, promenljive oba terma se mogu vezivati
+ * @param t1 - prvi term
+ * @param t2 - drugi term
+ * @param bindings - vezivanja koja se dopunjuju najopstijim unifikatorom
+ * @return true ako su termovi unifikabilni, false inace
+ */
+bool unify(const FlatTerm &t1, const FlatTerm &t2, FlatBindings &bindings);
+
+/**
+ * @brief match - jednosmerno uparivanje: trazi vezivanja tako da je pattern pod vezivanjima jednak targetu
+ * @details Promenljive terma 'target' se ne vezuju, vec se tretiraju kao konstante.
+ * @return true ako uparivanje postoji, false inace
+ */
+bool match(const FlatTerm &pattern, const FlatTerm &target, FlatBindings &bindings);
+
+std::ostream& operator<<(std::ostream &out, const FlatTerm &t);
+
+#endif // FLATTERM_H
@@ -1,21 +1,16 @@
 #include "forall.h"
 
 Forall::Forall(const Variable &var, const Formula &f)
-    : Quantifier (var, f)
+    : Quantifier (Kind::Forall, var, f)
 {
 }
 
-std::ostream &Forall::print(std::ostream &out) const
+Forall::Forall(const Variable &var, const Formula &body, LocallyNameless tag)
+    : Quantifier (Kind::Forall, var, body, tag)
 {
-    return printImpl(out, "V");
 }
 
-Formula Forall::substitute(const Variable &v, const Term &t) const
-{
-    return substituteImpl<Forall>(v, t);
-}
-
-Formula Forall::substitute(const Substitution &s) const
+std::ostream &Forall::print(std::ostream &out) const
 {
-    return substituteImpl<Forall>(s);
+    return printImpl(out, "V");
 }
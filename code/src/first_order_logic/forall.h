@@ -9,11 +9,11 @@ class Forall : public Quantifier
 public:
     Forall(const Variable &var, const Formula &f);
     
-    virtual std::ostream& print(std::ostream & out) const;
-  
-    virtual Formula substitute(const Variable & v, const Term & t) const;
+    Forall(const Variable &var, const Formula &body, LocallyNameless tag);
+    
+    static inline bool isKind(Kind kind) { return kind == Kind::Forall; }
     
-    virtual Formula substitute(const Substitution &s) const;
+    virtual std::ostream& print(std::ostream & out) const;
 };
 
 #endif // FORALL_H
@@ -1,12 +1,20 @@
 #include "function_term.h"
+#include "factory.h"
 
 #include <algorithm>
 #include <iterator>
 #include <stdexcept>
 
 FunctionTerm::FunctionTerm(const FunctionSymbol &symbol, const std::vector<Term> &terms)
-  : BaseTerm (), m_symbol{symbol}, m_terms{terms}
+  : BaseTerm (Kind::Function), m_symbol{symbol}, m_terms{terms}
 {
+  for (const auto &term : m_terms)
+  {
+    m_size += term->size();
+    m_depth = std::max(m_depth, term->depth() + 1);
+    m_varMask |= term->variablesMask();
+    m_looseBound = std::max(m_looseBound, term->looseBound());
+  }
 }
 
 std::ostream &FunctionTerm::print(std::ostream &out) const
@@ -28,11 +36,21 @@ std::ostream &FunctionTerm::print(std::ostream &out) const
   }
 }
 
-bool FunctionTerm::equalTo(const Term &oth) const
+std::size_t FunctionTerm::shallowHash() const
+{
+  std::size_t h = std::hash<FunctionSymbol>()(m_symbol);
+  for (const auto &term : m_terms)
+  {
+    h = hashCombine(h, term->hash());
+  }
+  return h;
+}
+
+bool FunctionTerm::shallowEqualTo(const BaseTerm &oth) const
 {
-  const FunctionTerm *pOth = dynamic_cast<const FunctionTerm*>(oth.get());
-  if (pOth)
+  if (oth.kind() == Kind::Function)
   {
+    const FunctionTerm *pOth = static_cast<const FunctionTerm*>(&oth);
     return symbol() == pOth->symbol() && 
         m_terms.size() == pOth->m_terms.size() &&
         std::equal(m_terms.cbegin(), m_terms.cend(), pOth->m_terms.cbegin());
@@ -53,6 +71,10 @@ void FunctionTerm::getVariables(VariablesSet &vset) const
 
 bool FunctionTerm::hasVariable(const Variable &v) const
 {
+  if (!(m_varMask & variableBit(v)))
+  {
+    return false;
+  }
   for (const auto &term : m_terms)
   {
     if (term->hasVariable(v))
@@ -63,21 +85,59 @@ bool FunctionTerm::hasVariable(const Variable &v) const
   return false;
 }
 
-Term FunctionTerm::substitute(const Variable &v, const Term &t) const
+Term FunctionTerm::substitute(const Substitution &s, SubstitutionMemo &memo) const
+{
+  if (!(m_varMask & memo.domain))
+  {
+    return self();
+  }
+  auto memoIt = memo.terms.find(this);
+  if (memoIt != memo.terms.cend())
+  {
+    return memoIt->second;
+  }
+
+  /* Novi cvor se pravi samo ako se neki od operanada promenio */
+  std::vector<Term> modifiedTerms;
+  bool changed = false;
+  modifiedTerms.reserve(m_terms.size());
+  for (const Term &t : m_terms)
+  {
+    modifiedTerms.push_back(t->substitute(s, memo));
+    changed = changed || modifiedTerms.back() != t;
+  }
+  Term result = changed ? Factory::make<FunctionTerm>(m_symbol, modifiedTerms)
+                        : self();
+  memo.terms.emplace(this, result);
+  return result;
+}
+
+Term FunctionTerm::abstractVariable(const Variable &v, unsigned index) const
 {
+  if (!hasVariable(v))
+  {
+    return self();
+  }
   std::vector<Term> terms;
   terms.reserve(m_terms.size());
-  std::transform(m_terms.cbegin(), m_terms.cend(), std::back_inserter(terms), [&](const Term &el) { return el->substitute(v, t); });
-  return std::make_shared<FunctionTerm>(m_symbol, terms);
+  for (const Term &t : m_terms)
+  {
+    terms.push_back(t->abstractVariable(v, index));
+  }
+  return Factory::make<FunctionTerm>(m_symbol, terms);
 }
 
-Term FunctionTerm::substitute(const Substitution &s) const
+Term FunctionTerm::instantiateBound(unsigned index, const Term &t) const
 {
-    std::vector<Term> modifiedTerms;
-    modifiedTerms.reserve(m_terms.size());
-    for (const Term & t : m_terms)
-    {
-        modifiedTerms.push_back(t->substitute(s));
-    }
-    return std::make_shared<FunctionTerm>(m_symbol, modifiedTerms);
+  if (m_looseBound <= index)
+  {
+    return self();
+  }
+  std::vector<Term> terms;
+  terms.reserve(m_terms.size());
+  for (const Term &term : m_terms)
+  {
+    terms.push_back(term->instantiateBound(index, t));
+  }
+  return Factory::make<FunctionTerm>(m_symbol, terms);
 }
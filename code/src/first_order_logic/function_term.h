@@ -11,21 +11,29 @@ class FunctionTerm : public BaseTerm
 public:
     FunctionTerm(const FunctionSymbol &symbol, const std::vector<Term> &terms = {});
     
+    static inline bool isKind(Kind kind) { return kind == Kind::Function; }
+    
     inline const FunctionSymbol& symbol() const { return m_symbol; }
     
     inline const std::vector<Term>& operands() const { return m_terms; }
     
     virtual std::ostream& print(std::ostream &out) const;
     
-    virtual bool equalTo(const Term &oth) const;
-    
     virtual void getVariables(VariablesSet &vset) const;
     
     virtual bool hasVariable(const Variable &v) const;
     
-    virtual Term substitute(const Variable &v, const Term &t) const;
+    virtual Term substitute(const Substitution &s, SubstitutionMemo &memo) const;
+    
+    virtual Term abstractVariable(const Variable &v, unsigned index) const;
     
-    virtual Term substitute(const Substitution &s) const;
+    virtual Term instantiateBound(unsigned index, const Term &t) const;
+
+protected:
+    virtual std::size_t shallowHash() const;
+    
+    virtual bool shallowEqualTo(const BaseTerm &oth) const;
+
 private:
     /**
      * @brief m_symbol je funkcijski simbol, na primer "+"
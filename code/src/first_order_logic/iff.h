@@ -8,11 +8,9 @@ class Iff : public BinaryConnective
 public:
     Iff(const Formula &op1, const Formula &op2);
     
-    virtual std::ostream& print(std::ostream & out) const;
-    
-    virtual Formula substitute(const Variable & v, const Term & t) const;
+    static inline bool isKind(Kind kind) { return kind == Kind::Iff; }
     
-    virtual Formula substitute(const Substitution &s) const;
+    virtual std::ostream& print(std::ostream & out) const;
 };
 
 #endif // IFF_H
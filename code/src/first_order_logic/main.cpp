@@ -1,4 +1,7 @@
 #include "first_order_logic.h"
+#include "factory.h"
+#include "unification.h"
+#include "resolution.h"
 
 #include <iostream>
 
@@ -18,44 +21,44 @@ int main()
     
     
     
-    Term xt = make_shared<VariableTerm>("x");
-    Term ut = make_shared<VariableTerm>("u");
-    Term vt = make_shared<VariableTerm>("v");
-    Term zt = make_shared<VariableTerm>("z");
-    Term ct = make_shared<FunctionTerm>(s, "c");
+    Term xt = Factory::make<VariableTerm>("x");
+    Term ut = Factory::make<VariableTerm>("u");
+    Term vt = Factory::make<VariableTerm>("v");
+    Term zt = Factory::make<VariableTerm>("z");
+    Term ct = Factory::make<FunctionTerm>("c");
     
     /* g(x) */
-    Term gt = make_shared<FunctionTerm>(s, "g", vector<Term> { xt });
+    Term gt = Factory::make<FunctionTerm>("g", vector<Term> { xt });
     
     /* p(x, g(x)) */
-    Formula px = make_shared<Atom>(s, "p", vector<Term> {xt, gt});
+    Formula px = Factory::make<Atom>("p", vector<Term> {xt, gt});
     
     /* p(u, v) */
-    Formula puv = make_shared<Atom>(s, "p", vector<Term> {ut, vt});
+    Formula puv = Factory::make<Atom>("p", vector<Term> {ut, vt});
     
     /* q(u, v) */
-    Formula quv = make_shared<Atom>(s, "q", vector<Term> {ut, vt});
+    Formula quv = Factory::make<Atom>("q", vector<Term> {ut, vt});
     
     /* q(c, z) */
-    Formula qcz = make_shared<Atom>(s, "q", vector<Term> {ct, zt});
+    Formula qcz = Factory::make<Atom>("q", vector<Term> {ct, zt});
     
     /* h(x) */
-    Term hx = make_shared<FunctionTerm>(s, "h", vector<Term> { xt });
+    Term hx = Factory::make<FunctionTerm>("h", vector<Term> { xt });
     
-    Term yt = make_shared<VariableTerm>("y");
-    Term wt = make_shared<VariableTerm>("w");
+    Term yt = Factory::make<VariableTerm>("y");
+    Term wt = Factory::make<VariableTerm>("w");
     
     /* g(z) */
-    Term gz = make_shared<FunctionTerm>(s, "g", vector<Term> { zt });
+    Term gz = Factory::make<FunctionTerm>("g", vector<Term> { zt });
     
     /* g(y) */
-    Term gy = make_shared<FunctionTerm>(s, "g", vector<Term> { yt });
+    Term gy = Factory::make<FunctionTerm>("g", vector<Term> { yt });
     
     /* f(x, h(x), y) */
-    Term f1 = make_shared<FunctionTerm>(s, "f", vector<Term> { xt, hx, yt });
+    Term f1 = Factory::make<FunctionTerm>("f", vector<Term> { xt, hx, yt });
     
     /* f(g(z), w, z) */
-    Term f2 = make_shared<FunctionTerm>(s, "f", vector<Term> { gz, wt, zt });
+    Term f2 = Factory::make<FunctionTerm>("f", vector<Term> { gz, wt, zt });
     
     /* Parovi termova: (g(y), x) i (f(x, h(x), y), f(g(z), w, z)) */
     TermPairs pairs { { gy, xt }, { f1, f2 } };
@@ -76,18 +79,18 @@ int main()
     }
     
     /* g(x0) */
-    Term x0 = make_shared<VariableTerm>("x0");
-    Term g1 = make_shared<FunctionTerm>(s, "g", vector<Term> { x0 });
+    Term x0 = Factory::make<VariableTerm>("x0");
+    Term g1 = Factory::make<FunctionTerm>("g", vector<Term> { x0 });
     
     /* g(x1) */
-    Term x1 = make_shared<VariableTerm>("x1");
-    Term g2 = make_shared<FunctionTerm>(s, "g", vector<Term> { x1 });
+    Term x1 = Factory::make<VariableTerm>("x1");
+    Term g2 = Factory::make<FunctionTerm>("g", vector<Term> { x1 });
     
     /* g(x2) */
-    Term x2 = make_shared<VariableTerm>("x2");
-    Term g3 = make_shared<FunctionTerm>(s, "g", vector<Term> { x2 });
+    Term x2 = Factory::make<VariableTerm>("x2");
+    Term g3 = Factory::make<FunctionTerm>("g", vector<Term> { x2 });
     
-    Term x3 = make_shared<VariableTerm>("x3");
+    Term x3 = Factory::make<VariableTerm>("x3");
     
     /* Parovi (x1, g(x0)), (x2, g(x1)), (x3, g(x2)) */
     TermPairs tp { { x1, g1 }, { x2, g2 }, { x3, g3 } };
@@ -105,8 +108,8 @@ int main()
     
     
     /* (g(h(x)), g(g(c))) */
-    Term ghx = make_shared<FunctionTerm>(s, "g", vector<Term> { make_shared<FunctionTerm>(s, "h", vector<Term> { xt }) });
-    Term ggc = make_shared<FunctionTerm>(s, "g", vector<Term> { make_shared<FunctionTerm>(s, "g", vector<Term> { ct }) });
+    Term ghx = Factory::make<FunctionTerm>("g", vector<Term> { Factory::make<FunctionTerm>("h", vector<Term> { xt }) });
+    Term ggc = Factory::make<FunctionTerm>("g", vector<Term> { Factory::make<FunctionTerm>("g", vector<Term> { ct }) });
     TermPairs tp2 { { ghx, ggc } };
     sub.clear();
     if(unify(tp2, sub))
@@ -122,32 +125,25 @@ int main()
 //    CNF cnf(3);
     
 //    cnf[0].push_back(px);
-//    cnf[1].push_back(make_shared<Not>(puv));
+//    cnf[1].push_back(Factory::make<Not>(puv));
 //    cnf[1].push_back(quv);
-//    cnf[2].push_back(make_shared<Not>(qcz));
+//    cnf[2].push_back(Factory::make<Not>(qcz));
     
     CNF cnf(2);
     
-    Formula pcx = make_shared<Atom>(s, "p", vector<Term> { ct, xt });
-    Formula pxx = make_shared<Atom>(s, "p", vector<Term> { xt, xt });
-    Formula pcy = make_shared<Atom>(s, "p", vector<Term> { ct, yt });
-    Formula pyy = make_shared<Atom>(s, "p", vector<Term> { yt, yt });
+    Formula pcx = Factory::make<Atom>("p", vector<Term> { ct, xt });
+    Formula pxx = Factory::make<Atom>("p", vector<Term> { xt, xt });
+    Formula pcy = Factory::make<Atom>("p", vector<Term> { ct, yt });
+    Formula pyy = Factory::make<Atom>("p", vector<Term> { yt, yt });
     
-    cnf[0].push_back(make_shared<Not>(pcx));
-    cnf[0].push_back(make_shared<Not>(pxx));
+    cnf[0].push_back(Factory::make<Not>(pcx));
+    cnf[0].push_back(Factory::make<Not>(pxx));
     cnf[1].push_back(pcy);
     cnf[1].push_back(pyy);
     
     cout << cnf << endl;
     
-    if(resolution(cnf))
-    {
-        cout << "CNF satisfiable!" << endl;
-    }
-    else
-    {
-        cout << "CNF unsatisfiable!" << endl;
-    }
+    cout << "CNF " << resolution(cnf) << "!" << endl;
     
     return 0;
 }
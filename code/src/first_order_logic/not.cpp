@@ -8,20 +8,10 @@
 #include "exists.h"
 
 Not::Not(const Formula &f)
-    : UnaryConnective (f)
+    : UnaryConnective (Kind::Not, f)
 {
 }
 
-Formula Not::substitute(const Variable &v, const Term &t) const
-{
-    return std::make_shared<Not>(m_op->substitute(v, t));
-}
-
-Formula Not::substitute(const Substitution &s) const
-{
-    return std::make_shared<Not>(m_op->substitute(s));
-}
-
 std::ostream &Not::print(std::ostream &out) const
 {
     out << "~(";
@@ -8,9 +8,7 @@ class Not : public UnaryConnective
 public:
     Not(const Formula &f);
     
-    virtual Formula substitute(const Variable & v, const Term & t) const;
-    
-    virtual Formula substitute(const Substitution &s) const;
+    static inline bool isKind(Kind kind) { return kind == Kind::Not; }
     
     virtual std::ostream& print(std::ostream & out) const;
 };
@@ -77,9 +77,9 @@ std::optional<Formula> FormulaParser::ParseInternal<Formula>(const std::string&
 		switch (formulaString[0])
 		{
 		case 'T':
-			return std::make_shared<True>();
+			return Factory::make<True>();
 		case 'F':
-			return std::make_shared<False>();
+			return Factory::make<False>();
 		default:
 			return TryMakeAtom(formulaString, std::vector<Term>());
 		}
@@ -101,38 +101,38 @@ std::optional<Formula> FormulaParser::ParseInternal<Formula>(const std::string&
 	if (fn_name == "not")
 	{
 		auto args = ParseAndConvertArgs<Formula>(args_string);
-		return args.has_value() ? std::optional(std::make_shared<Not>(std::get<0>(args.value()))) : std::nullopt;
+		return args.has_value() ? std::optional(Factory::make<Not>(std::get<0>(args.value()))) : std::nullopt;
 	}
 	else if (fn_name == "or")
 	{
 		auto args = ParseAndConvertArgs<Formula, Formula>(args_string);
-		return args.has_value() ? std::optional(std::make_shared<Or>(std::get<0>(args.value()), std::get<1>(args.value()))) : std::nullopt;
+		return args.has_value() ? std::optional(Factory::make<Or>(std::get<0>(args.value()), std::get<1>(args.value()))) : std::nullopt;
 	}
 	else if (fn_name == "and")
 	{
 		auto args = ParseAndConvertArgs<Formula, Formula>(args_string);
-		return args.has_value() ? std::optional(std::make_shared<And>(std::get<0>(args.value()), std::get<1>(args.value()))) : std::nullopt;
+		return args.has_value() ? std::optional(Factory::make<And>(std::get<0>(args.value()), std::get<1>(args.value()))) : std::nullopt;
 	}
 	else if (fn_name == "imp")
 	{
 		auto args = ParseAndConvertArgs<Formula, Formula>(args_string);
-		return args.has_value() ? std::optional(std::make_shared<Imp>(std::get<0>(args.value()), std::get<1>(args.value()))) : std::nullopt;
+		return args.has_value() ? std::optional(Factory::make<Imp>(std::get<0>(args.value()), std::get<1>(args.value()))) : std::nullopt;
 	}
 	else if (fn_name == "iff")
 	{
 		auto args = ParseAndConvertArgs<Formula, Formula>(args_string);
-		return args.has_value() ? std::optional(std::make_shared<Iff>(std::get<0>(args.value()), std::get<1>(args.value()))) : std::nullopt;
+		return args.has_value() ? std::optional(Factory::make<Iff>(std::get<0>(args.value()), std::get<1>(args.value()))) : std::nullopt;
 	}
 	else if (fn_name == "forall")
 	{
 		//technically, the first param is not a term but a variable, but as far as parsing goes we don't really care
 		auto args = ParseAndConvertArgs<Variable, Formula>(args_string);
-		return args.has_value() ? std::optional(std::make_shared<Forall>(std::get<0>(args.value()), std::get<1>(args.value()))) : std::nullopt;
+		return args.has_value() ? std::optional(Factory::make<Forall>(std::get<0>(args.value()), std::get<1>(args.value()))) : std::nullopt;
 	}
 	else if (fn_name == "exists")
 	{
 		auto args = ParseAndConvertArgs<Variable, Formula>(args_string);
-		return args.has_value() ? std::optional(std::make_shared<Exists>(std::get<0>(args.value()), std::get<1>(args.value()))) : std::nullopt;
+		return args.has_value() ? std::optional(Factory::make<Exists>(std::get<0>(args.value()), std::get<1>(args.value()))) : std::nullopt;
 	}
 	else
 	{
@@ -201,7 +201,7 @@ std::optional<Term> FormulaParser::ParseInternal<Term>(const std::string& termSt
 	auto variable = ParseInternal<Variable>(termString);
 	if (variable.has_value())
 	{
-		return std::make_shared<VariableTerm>(variable.value());
+		return Factory::make<VariableTerm>(variable.value());
 	}
 	else
 	{
@@ -311,18 +311,18 @@ std::optional<Formula> FormulaParser::TryMakeAtom(const RelationSymbol& symbol,
 {
 	if (VariableExists(symbol))
 	{
-		m_error = "Cannot use " + symbol + " as a relation symbol because there's already a term by the same name.";
+		m_error = "Cannot use " + symbol.name() + " as a relation symbol because there's already a term by the same name.";
 		return std::nullopt;
 	}
 
 	Arity existingRelationSymbolArity;
 	if (RelationSymbolExists(symbol, existingRelationSymbolArity) && existingRelationSymbolArity != terms.size())
 	{
-		m_error = "Relation symbol " + symbol + " already exists, but with different arity.";
+		m_error = "Relation symbol " + symbol.name() + " already exists, but with different arity.";
 		return std::nullopt;
 	}
 
-	auto atom = std::make_shared<Atom>(symbol, terms);
+	auto atom = Factory::make<Atom>(symbol, terms);
 	auto& atomIt = m_parsedAtoms[symbol];
 	std::get<0>(atomIt).push_back(atom);
 	std::get<1>(atomIt) = terms.size();
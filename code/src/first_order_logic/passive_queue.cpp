@@ -0,0 +1,88 @@
+#include "passive_queue.h"
+
+#include <algorithm>
+#include <functional>
+
+PassiveQueue::PassiveQueue(unsigned ratio)
+    : m_ratio(ratio)
+{
+}
+
+void PassiveQueue::push(std::uint32_t clause, std::uint32_t weight)
+{
+    if (clause >= m_queued.size())
+    {
+        m_queued.resize(clause + 1, false);
+    }
+    if (m_queued[clause])
+    {
+        return;
+    }
+    m_queued[clause] = true;
+    ++m_size;
+
+    m_byWeight.emplace_back(weight, clause);
+    std::push_heap(m_byWeight.begin(), m_byWeight.end(), std::greater<Entry>());
+    m_byAge.push_back(clause);
+}
+
+bool PassiveQueue::pop(std::uint32_t &clause)
+{
+    if (m_size == 0)
+    {
+        return false;
+    }
+
+    /* Svaka klauza iz reda je u oba niza, pa izabrani niz sigurno sadrzi neku */
+    bool byAge = m_ratio == 0 || m_picks % (m_ratio + 1) == m_ratio;
+    ++m_picks;
+    if (byAge)
+    {
+        do
+        {
+            clause = m_byAge[m_ageCursor++];
+        } while (!m_queued[clause]);
+    }
+    else
+    {
+        do
+        {
+            std::pop_heap(m_byWeight.begin(), m_byWeight.end(), std::greater<Entry>());
+            clause = m_byWeight.back().second;
+            m_byWeight.pop_back();
+        } while (!m_queued[clause]);
+    }
+
+    m_queued[clause] = false;
+    --m_size;
+    compact();
+    return true;
+}
+
+void PassiveQueue::remove(std::uint32_t clause)
+{
+    if (contains(clause))
+    {
+        m_queued[clause] = false;
+        --m_size;
+        compact();
+    }
+}
+
+void PassiveQueue::compact()
+{
+    auto stale = [this](std::uint32_t clause) { return !m_queued[clause]; };
+    if (m_byWeight.size() > 2 * m_size)
+    {
+        m_byWeight.erase(std::remove_if(m_byWeight.begin(), m_byWeight.end(),
+                                        [&](const Entry &e) { return stale(e.second); }),
+                         m_byWeight.end());
+        std::make_heap(m_byWeight.begin(), m_byWeight.end(), std::greater<Entry>());
+    }
+    /* Ceo izabrani pocetak reda po starosti je zastareo, pa se brise zajedno sa ostalim zastarelim ulazima */
+    if (m_byAge.size() > 2 * m_size)
+    {
+        m_byAge.erase(std::remove_if(m_byAge.begin(), m_byAge.end(), stale), m_byAge.end());
+        m_ageCursor = 0;
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef PASSIVEQUEUE_H
+#define PASSIVEQUEUE_H
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief PassiveQueue - red pasivnih klauza petlje izabrane klauze (given-clause)
+ *
+ * @details Klauza se istovremeno nalazi u dva reda: u hipu uredjenom po tezini (pa po
+ * starosti) i u redu po starosti. Na svakih 'ratio' izbora po tezini dolazi jedan izbor po
+ * starosti (pick-given ratio kao u Otter-u), pa i teske klauze na kraju budu izabrane.
+ * Izbacena ili vec izabrana klauza ostaje u drugom redu i preskace se kada dodje na red.
+ * Kada zastarelih ulaza u nekom redu bude vise nego klauza u redu, red se sazima, pa
+ * zauzeta memorija zavisi od broja klauza u redu, a ne od broja svih dodatih klauza.
+ * Klauze se identifikuju rastucim indeksima, pa je indeks ujedno i starost.
+ */
+class PassiveQueue
+{
+public:
+    /**
+     * @brief PassiveQueue konstruktor
+     * @param ratio - broj izbora po tezini na jedan izbor po starosti, 0 znaci samo po starosti
+     */
+    explicit PassiveQueue(unsigned ratio = 5);
+
+    void push(std::uint32_t clause, std::uint32_t weight);
+
+    /**
+     * @brief pop - bira sledecu klauzu
+     * @return false ako je red prazan
+     */
+    bool pop(std::uint32_t &clause);
+
+    /**
+     * @brief remove - izbacuje klauzu iz reda (na primer kada je sadrzana u nekoj drugoj)
+     */
+    void remove(std::uint32_t clause);
+
+    inline bool contains(std::uint32_t clause) const { return clause < m_queued.size() && m_queued[clause]; }
+
+    inline std::size_t size() const { return m_size; }
+
+    inline bool empty() const { return m_size == 0; }
+
+private:
+    using Entry = std::pair<std::uint32_t, std::uint32_t>;
+
+    /**
+     * @brief compact - izbacuje zastarele ulaze iz reda u kome ih ima vise nego klauza u redu
+     */
+    void compact();
+
+    unsigned m_ratio;
+    unsigned m_picks = 0;
+    /* Min-hip parova (tezina, indeks) */
+    std::vector<Entry> m_byWeight;
+    std::vector<std::uint32_t> m_byAge;
+    std::size_t m_ageCursor = 0;
+    std::vector<bool> m_queued;
+    std::size_t m_size = 0;
+};
+
+#endif // PASSIVEQUEUE_H
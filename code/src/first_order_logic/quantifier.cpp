@@ -1,58 +1,154 @@
 #include "quantifier.h"
+#include "forall.h"
+#include "exists.h"
 
 #include <algorithm>
+#include <string>
 
-uint64_t Quantifier::s_UniqueCounter = 0U;
+/**
+ * @brief displayName - ime vezane promenljive koje se ne poklapa ni sa jednom slobodnom promenljivom tela
+ * @details Do sudara dolazi samo kada supstitucija unese slobodnu promenljivu istog imena u telo,
+ * tada se imenu dodaje redni broj.
+ */
+static Variable displayName(const Variable &var, const Formula &body)
+{
+  if (!body->hasVariable(var, true))
+  {
+    return var;
+  }
+  Variable unique;
+  unsigned counter = 1;
+  do {
+    unique = var.name() + std::to_string(counter++);
+  } while (body->hasVariable(unique, true));
+  return unique;
+}
+
+Quantifier::Quantifier(Kind kind, const Variable &var, const Formula &f)
+  : BaseFormula (kind), m_var(var), m_op(f->abstractVariable(var, 0))
+{
+  initMetadata();
+}
+
+Quantifier::Quantifier(Kind kind, const Variable &var, const Formula &body, LocallyNameless)
+  : BaseFormula (kind), m_var(displayName(var, body)), m_op(body)
+{
+  initMetadata();
+}
+
+void Quantifier::initMetadata()
+{
+  m_size = 1 + m_op->size();
+  m_depth = 1 + m_op->depth();
+  m_complexity = 1 + m_op->complexity();
+  m_varMask = m_op->variablesMask() | variableBit(m_var);
+  m_ground = m_op->isGround();
+  m_looseBound = m_op->looseBound() > 0 ? m_op->looseBound() - 1 : 0;
+}
 
-Quantifier::Quantifier(const Variable &var, const Formula &f)
-  : BaseFormula (), m_var(var), m_op(f)
+std::size_t Quantifier::shallowHash() const
 {
+  return hashCombine(std::hash<Variable>()(m_var), m_op->hash());
 }
 
-unsigned Quantifier::complexity() const
+bool Quantifier::shallowEqualTo(const BaseFormula &f) const
 {
-  return 1 + m_op->complexity();
+  if (BaseFormula::shallowEqualTo(f))
+  {
+    return m_var == static_cast<const Quantifier&>(f).m_var &&
+        m_op->equalTo(static_cast<const Quantifier&>(f).m_op);
+  }
+  return false;
 }
 
-bool Quantifier::equalTo(const Formula &f) const
+bool Quantifier::alphaEquivalentTo(const BaseFormula &f) const
 {
-  if (BaseFormula::equalTo(f))
+  /* Ime vezane promenljive se zanemaruje, tela se porede sa istim indeksima */
+  if (BaseFormula::shallowEqualTo(f))
   {
-    return m_var == static_cast<const Quantifier*>(f.get())->m_var &&
-        m_op->equalTo(static_cast<const Quantifier*>(f.get())->m_op);
+    return m_op->alphaEquivalent(static_cast<const Quantifier&>(f).m_op);
   }
   return false;
 }
 
+bool Quantifier::containsVariable(const Variable &v, bool free) const
+{
+  if (!free && v == m_var)
+  {
+    return true;
+  }
+  return m_op->hasVariable(v, free);
+}
+
 void Quantifier::getVars(VariablesSet &vars, bool free) const
 {
-  VariablesSet tmp;
-  m_op->getVars(tmp);
-  if (free)
+  if (!free)
+  {
+    vars.insert(m_var);
+  }
+  m_op->getVars(vars, free);
+}
+
+Formula Quantifier::operand() const
+{
+  return instantiate(Factory::make<VariableTerm>(m_var));
+}
+
+Formula Quantifier::instantiate(const Term &t) const
+{
+  return m_op->instantiateBound(0, t);
+}
+
+Formula Quantifier::rebuild(const Formula &body) const
+{
+  if (body == m_op)
+  {
+    return self();
+  }
+  if (kind() == Kind::Forall)
+  {
+    return Factory::make<Forall>(m_var, body, LocallyNameless{});
+  }
+  return Factory::make<Exists>(m_var, body, LocallyNameless{});
+}
+
+Formula Quantifier::substitute(const Substitution &s, SubstitutionMemo &memo) const
+{
+  if (!(m_varMask & memo.domain))
+  {
+    return self();
+  }
+  auto memoIt = memo.formulas.find(this);
+  if (memoIt != memo.formulas.cend())
+  {
+    return memoIt->second;
+  }
+  Formula result = rebuild(m_op->substitute(s, memo));
+  memo.formulas.emplace(this, result);
+  return result;
+}
+
+Formula Quantifier::abstractVariable(const Variable &v, unsigned index) const
+{
+  if (!(m_varMask & variableBit(v)))
   {
-    tmp.erase(m_var);
+    return self();
   }
-  vars.insert(tmp.cbegin(), tmp.cend());
+  return rebuild(m_op->abstractVariable(v, index + 1));
 }
 
-Variable Quantifier::getUniqueVarName(const Formula &f, const std::vector<Term> &terms)
+Formula Quantifier::instantiateBound(unsigned index, const Term &t) const
 {
-    Variable unique;
-    do {
-        unique = "uv" + std::to_string(s_UniqueCounter++);
-    } while (f->hasVariable(unique) || 
-             terms.cend() != std::find_if(terms.cbegin(), 
-                                          terms.cend(), 
-                                          [&](const Term &t) 
-                                            { return t->hasVariable(unique); } 
-                                       ));
-    
-    return unique;
+  if (m_looseBound <= index)
+  {
+    return self();
+  }
+  return rebuild(m_op->instantiateBound(index + 1, t));
 }
 
 std::ostream &Quantifier::printImpl(std::ostream &out, const std::string &symbol) const
 {
   out << '(' << symbol << '.' << m_var << ")(";
-  m_op->print(out);
+  operand()->print(out);
   return out << ')';
 }
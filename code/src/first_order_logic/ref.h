@@ -0,0 +1,191 @@
+#ifndef REF_H
+#define REF_H
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+/**
+ * @brief RefCounted - bazna klasa objekata sa ugradjenim (intruzivnim) brojacem referenci
+ *
+ * @details Brojac je obican ceo broj, a ne atomicki, jer se jezgro logike i dokazivac koriste
+ * iz jedne niti. Kopiranje reference zato ne dira deljene kes linije kao kod std::shared_ptr.
+ * Kopija objekta pocinje sa brojacem 0, brojac pripada objektu a ne njegovoj vrednosti.
+ */
+class RefCounted
+{
+public:
+    inline void addRef() const { ++m_refCount; }
+
+    inline void release() const
+    {
+        if (--m_refCount == 0)
+        {
+            destroy();
+        }
+    }
+
+    inline unsigned refCount() const { return m_refCount; }
+
+protected:
+    RefCounted() = default;
+
+    RefCounted(const RefCounted &) : m_refCount(0) {}
+
+    RefCounted& operator=(const RefCounted &) { return *this; }
+
+    virtual ~RefCounted() = default;
+
+    /**
+     * @brief destroy - unistava objekat kada broj referenci padne na 0
+     * @details Podrazumevano se objekat brise sa delete, izvedene klase koje se alociraju
+     * drugacije (na primer iz regiona) menjaju ovo ponasanje.
+     */
+    virtual void destroy() const { delete this; }
+
+private:
+    mutable unsigned m_refCount = 0;
+};
+
+/**
+ * @brief Ref - pametni pokazivac na objekat izveden iz RefCounted
+ *
+ * @details Zamena za std::shared_ptr u jezgru logike: velicine je jednog pokazivaca,
+ * a referenca na tekuci objekat se pravi direktno iz 'this' (nema shared_from_this).
+ */
+template <typename T>
+class Ref
+{
+public:
+    Ref() = default;
+
+    Ref(std::nullptr_t) {}
+
+    Ref(T *ptr)
+        : m_ptr(ptr)
+    {
+        if (m_ptr)
+        {
+            m_ptr->addRef();
+        }
+    }
+
+    Ref(const Ref &oth)
+        : Ref(oth.m_ptr)
+    {
+    }
+
+    Ref(Ref &&oth)
+        : m_ptr(oth.m_ptr)
+    {
+        oth.m_ptr = nullptr;
+    }
+
+    template <typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    Ref(const Ref<U> &oth)
+        : Ref(oth.get())
+    {
+    }
+
+    template <typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+    Ref(Ref<U> &&oth)
+        : m_ptr(oth.detach())
+    {
+    }
+
+    ~Ref()
+    {
+        if (m_ptr)
+        {
+            m_ptr->release();
+        }
+    }
+
+    Ref& operator=(Ref oth)
+    {
+        std::swap(m_ptr, oth.m_ptr);
+        return *this;
+    }
+
+    inline T* get() const { return m_ptr; }
+
+    inline T* operator->() const { return m_ptr; }
+
+    inline T& operator*() const { return *m_ptr; }
+
+    inline explicit operator bool() const { return m_ptr != nullptr; }
+
+    inline void reset() { Ref().swap(*this); }
+
+    inline void swap(Ref &oth) { std::swap(m_ptr, oth.m_ptr); }
+
+    /**
+     * @brief detach - predaje vlasnistvo nad objektom bez promene brojaca
+     */
+    inline T* detach()
+    {
+        T *ptr = m_ptr;
+        m_ptr = nullptr;
+        return ptr;
+    }
+
+private:
+    T *m_ptr = nullptr;
+};
+
+template <typename T, typename U>
+inline bool operator==(const Ref<T> &lhs, const Ref<U> &rhs) { return lhs.get() == rhs.get(); }
+
+template <typename T, typename U>
+inline bool operator!=(const Ref<T> &lhs, const Ref<U> &rhs) { return lhs.get() != rhs.get(); }
+
+template <typename T>
+inline bool operator==(const Ref<T> &lhs, std::nullptr_t) { return lhs.get() == nullptr; }
+
+template <typename T>
+inline bool operator!=(const Ref<T> &lhs, std::nullptr_t) { return lhs.get() != nullptr; }
+
+template <typename T>
+inline bool operator<(const Ref<T> &lhs, const Ref<T> &rhs) { return std::less<T*>()(lhs.get(), rhs.get()); }
+
+/**
+ * @brief makeRef - pravi novi objekat na hipu i vraca referencu na njega
+ */
+template <typename T, typename... Args>
+inline Ref<T> makeRef(Args&&... args)
+{
+    return Ref<T>(new T(std::forward<Args>(args)...));
+}
+
+template <typename T, typename U>
+inline Ref<T> staticCast(const Ref<U> &ref)
+{
+    return Ref<T>(static_cast<T*>(ref.get()));
+}
+
+template <typename T, typename U>
+inline Ref<T> constCast(const Ref<U> &ref)
+{
+    return Ref<T>(const_cast<T*>(ref.get()));
+}
+
+template <typename T, typename U>
+inline Ref<T> dynamicCast(const Ref<U> &ref)
+{
+    return Ref<T>(dynamic_cast<T*>(ref.get()));
+}
+
+namespace std
+{
+    template <typename T>
+    struct hash<Ref<T>>
+    {
+        std::size_t operator()(const Ref<T> &ref) const
+        {
+            return std::hash<T*>()(ref.get());
+        }
+    };
+}
+
+#endif // REF_H
@@ -0,0 +1,61 @@
+#include "region.h"
+#include "common.h"
+
+#include <algorithm>
+#include <cstdint>
+
+Region::Region(std::size_t blockSize)
+    : m_blockSize(blockSize)
+{
+}
+
+void *Region::allocate(std::size_t bytes, std::size_t align)
+{
+    std::uintptr_t cursor = reinterpret_cast<std::uintptr_t>(m_cursor);
+    std::uintptr_t aligned = (cursor + align - 1) & ~(static_cast<std::uintptr_t>(align) - 1);
+
+    /* Ako nema mesta u tekucem bloku, uzimamo novi (veci ako zahtev ne staje u blok) */
+    if (!m_cursor || aligned + bytes > reinterpret_cast<std::uintptr_t>(m_end))
+    {
+        std::size_t size = std::max(m_blockSize, bytes + align);
+        m_blocks.emplace_back(new char[size]);
+        m_reserved += size;
+        m_cursor = m_blocks.back().get();
+        m_end = m_cursor + size;
+
+        cursor = reinterpret_cast<std::uintptr_t>(m_cursor);
+        aligned = (cursor + align - 1) & ~(static_cast<std::uintptr_t>(align) - 1);
+    }
+
+    m_cursor = reinterpret_cast<char*>(aligned + bytes);
+    m_live += bytes;
+    return reinterpret_cast<void*>(aligned);
+}
+
+void Region::deallocate(void *p, std::size_t bytes)
+{
+    UNUSED_ARG(p);
+    m_live -= bytes;
+}
+
+Ref<Region> &Region::currentRef()
+{
+    static Ref<Region> *s_current = new Ref<Region>();
+    return *s_current;
+}
+
+const Ref<Region> &Region::current()
+{
+    return currentRef();
+}
+
+Region::Scope::Scope(Ref<Region> region)
+    : m_previous(std::move(currentRef()))
+{
+    currentRef() = std::move(region);
+}
+
+Region::Scope::~Scope()
+{
+    currentRef() = std::move(m_previous);
+}
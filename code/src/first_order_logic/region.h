@@ -0,0 +1,128 @@
+#ifndef REGION_H
+#define REGION_H
+
+#include "ref.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Region - alokator memorije "na guranje" (bump allocator) za cvorove termova i formula
+ *
+ * @details Region je vlasnistvo jedne sesije (ND::Solver) ili jednog poziva rezolucije.
+ * Dok je region aktivan (videti Region::Scope), Factory sve nove cvorove alocira iz njega.
+ * Pojedinacna oslobadjanja se ne vrse, vec se sva memorija oslobadja odjednom kada
+ * se region unisti. Svaki cvor drzi referencu na svoj region, pa region zivi dok
+ * god postoji ijedan cvor alociran u njemu.
+ */
+class Region : public RefCounted
+{
+public:
+    /**
+     * @brief Region konstruktor
+     * @param blockSize - velicina jednog bloka memorije u bajtovima
+     */
+    explicit Region(std::size_t blockSize = 64 * 1024);
+
+    Region(const Region &) = delete;
+
+    Region& operator=(const Region &) = delete;
+
+    /**
+     * @brief allocate - alocira 'bytes' bajtova poravnatih na 'align'
+     */
+    void* allocate(std::size_t bytes, std::size_t align);
+
+    /**
+     * @brief deallocate - evidentira oslobadjanje, memorija se vraca tek unistenjem regiona
+     */
+    void deallocate(void *p, std::size_t bytes);
+
+    /**
+     * @brief bytesReserved - ukupna velicina svih blokova regiona
+     */
+    inline std::size_t bytesReserved() const { return m_reserved; }
+
+    /**
+     * @brief bytesLive - broj bajtova koji su alocirani a nisu oslobodjeni
+     */
+    inline std::size_t bytesLive() const { return m_live; }
+
+    /**
+     * @brief current - trenutno aktivan region, nullptr ako ga nema
+     */
+    static const Ref<Region>& current();
+
+    /**
+     * @brief Scope - RAII objekat koji postavlja aktivan region do kraja svog opsega
+     */
+    class Scope
+    {
+    public:
+        explicit Scope(Ref<Region> region);
+
+        Scope(const Scope &) = delete;
+
+        Scope& operator=(const Scope &) = delete;
+
+        ~Scope();
+
+    private:
+        Ref<Region> m_previous;
+    };
+
+private:
+    static Ref<Region>& currentRef();
+
+    std::size_t m_blockSize;
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    char *m_cursor = nullptr;
+    char *m_end = nullptr;
+    std::size_t m_reserved = 0;
+    std::size_t m_live = 0;
+};
+
+/**
+ * @brief RegionAllocator - STL alokator nad regionom, za kontejnere ciji elementi zive koliko i region
+ */
+template <typename T>
+class RegionAllocator
+{
+public:
+    using value_type = T;
+
+    explicit RegionAllocator(Ref<Region> region)
+        : m_region(std::move(region))
+    {
+    }
+
+    template <typename U>
+    RegionAllocator(const RegionAllocator<U> &oth)
+        : m_region(oth.region())
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(m_region->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T *p, std::size_t n)
+    {
+        m_region->deallocate(p, n * sizeof(T));
+    }
+
+    inline const Ref<Region>& region() const { return m_region; }
+
+    template <typename U>
+    bool operator==(const RegionAllocator<U> &oth) const { return m_region == oth.region(); }
+
+    template <typename U>
+    bool operator!=(const RegionAllocator<U> &oth) const { return m_region != oth.region(); }
+
+private:
+    Ref<Region> m_region;
+};
+
+#endif // REGION_H
@@ -1,34 +1,818 @@
 #include "resolution.h"
 #include "first_order_logic.h"
 #include "unification.h"
+#include "clause_store.h"
+#include "discrimination_tree.h"
+#include "feature_vector_index.h"
+#include "passive_queue.h"
+#include "term_ordering.h"
+#include "region.h"
 
 #include <algorithm>
+#include <chrono>
 #include <iterator>
+#include <memory>
+#include <unordered_set>
 
-static OptionalSubstitution unify(const Atom *a1, const Atom *a2)
+/**
+ * Literal rezolvente pre primene supstitucije (deljenje strukture u stilu Boyer-Moore-a):
+ * literal roditeljske klauze i okruzenje (najopstiji unifikator) pod kojim ga treba citati.
+ * Vecina rezolventi se odbaci kao tautologija ili kao vec postojeca klauza, pa se konkretni
+ * literali prave tek kada se rezolventa zadrzi. Vrednosti iz okruzenja su konkretni termovi i
+ * ne citaju se ponovo pod njim. Okruzenje premise iz banke vece od 0 (videti bankVariable)
+ * slika i nevezane promenljive premise u promenljive te banke. Okruzenje nullptr oznacava
+ * konkretan literal.
+ */
+struct LazyLiteral
 {
-    /**
-     * Ovo je pomocna funkcija u kojoj vadimo parove termova iz atoma 
-     * kako bismo probali da unifikujemo 2 atoma.
-     */
+    ClauseLiteral literal;
+    const Substitution *env;
+};
+
+using LazyClause = std::vector<LazyLiteral>;
+
+static Term deref(const Term &t, const Substitution *env)
+{
+    if (env && t->kind() == BaseTerm::Kind::Variable)
+    {
+        auto it = env->find(static_cast<const VariableTerm*>(t.get())->variable());
+        if (it != env->cend())
+        {
+            return it->second;
+        }
+    }
+    return t;
+}
+
+static bool equalUnder(const Term &t1, const Substitution *env1, const Term &t2, const Substitution *env2)
+{
+    /* Isti cvor pod istim okruzenjem daje isti term */
+    if (t1 == t2 && env1 == env2)
+    {
+        return true;
+    }
+    
+    /* Vrednosti iz okruzenja su vec konkretni termovi, pa se dalje citaju bez okruzenja */
+    Term r1 = deref(t1, env1);
+    Term r2 = deref(t2, env2);
+    if (r1 != t1 || r1->isGround())
+    {
+        env1 = nullptr;
+    }
+    if (r2 != t2 || r2->isGround())
+    {
+        env2 = nullptr;
+    }
+    
+    /* Promenljiva van domena ostaje ista, a konkretni termovi se porede pokazivacem */
+    if ((!env1 && !env2) || 
+        r1->kind() == BaseTerm::Kind::Variable || 
+        r2->kind() == BaseTerm::Kind::Variable)
+    {
+        return r1 == r2;
+    }
+    
+    const FunctionTerm *f1 = static_cast<const FunctionTerm*>(r1.get());
+    const FunctionTerm *f2 = static_cast<const FunctionTerm*>(r2.get());
+    if (f1->symbol() != f2->symbol() || f1->operands().size() != f2->operands().size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < f1->operands().size(); ++i)
+    {
+        if (!equalUnder(f1->operands()[i], env1, f2->operands()[i], env2))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool atomsEqualUnder(const Atom *a1, const Substitution *env1, const Atom *a2, const Substitution *env2)
+{
+    if (a1->symbol() != a2->symbol() || a1->getArity() != a2->getArity())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < a1->getArity(); ++i)
+    {
+        if (!equalUnder(a1->operands()[i], env1, a2->operands()[i], env2))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool literalsEqualUnder(const ClauseLiteral &l1, const Substitution *env1, const ClauseLiteral &l2, const Substitution *env2)
+{
+    if (l1 == l2 && env1 == env2)
+    {
+        return true;
+    }
+    return l1.negated() == l2.negated() && atomsEqualUnder(l1.atom(), env1, l2.atom(), env2);
+}
+
+static std::vector<ClauseLiteral> materialize(const LazyClause &c)
+{
+    std::vector<ClauseLiteral> concrete;
+    concrete.reserve(c.size());
+    for (const auto &l : c)
+    {
+        concrete.push_back(l.env ? l.literal.substitute(*l.env) : l.literal);
+    }
+    return concrete;
+}
+
+/**
+ * @brief depthUnder - dubina terma 't' procitanog pod okruzenjem 'env'
+ */
+static unsigned depthUnder(const Term &t, const Substitution *env)
+{
+    if (!env || t->isGround())
+    {
+        return t->depth();
+    }
+    if (t->kind() == BaseTerm::Kind::Variable)
+    {
+        return deref(t, env)->depth();
+    }
     
-    if (a1->symbol() != a2->symbol())
+    unsigned depth = 0;
+    for (const Term &op : static_cast<const FunctionTerm*>(t.get())->operands())
+    {
+        depth = std::max(depth, depthUnder(op, env));
+    }
+    return depth + 1;
+}
+
+/**
+ * @brief addLiteralFeatures - dodaje osobine literala 'l' procitanog pod okruzenjem 'env'
+ */
+static void addLiteralFeatures(FeatureVector &features, const ClauseLiteral &l, const Substitution *env)
+{
+    const Atom *a = l.atom();
+    unsigned depth = 0;
+    for (const Term &op : a->operands())
+    {
+        depth = std::max(depth, depthUnder(op, env));
+    }
+    features.addLiteral(a->symbol(), l.negated(), depth);
+}
+
+/**
+ * @brief clauseFeatures - vektor osobina klauze, ponovljeni literali se broje jednom
+ */
+static FeatureVector clauseFeatures(const LazyClause &c)
+{
+    FeatureVector features;
+    for (size_t i = 0; i < c.size(); ++i)
+    {
+        bool repeated = false;
+        for (size_t j = 0; j < i && !repeated; ++j)
+        {
+            repeated = literalsEqualUnder(c[j].literal, c[j].env, c[i].literal, c[i].env);
+        }
+        if (!repeated)
+        {
+            addLiteralFeatures(features, c[i].literal, c[i].env);
+        }
+    }
+    return features;
+}
+
+static FeatureVector clauseFeatures(const ClauseView &c)
+{
+    /* Klauza iz skladista nema ponovljenih literala */
+    FeatureVector features;
+    for (const ClauseLiteral &l : c)
+    {
+        addLiteralFeatures(features, l, nullptr);
+    }
+    return features;
+}
+
+/**
+ * @brief ClauseVariant - kanonski zapis klauze, isti za sve klauze koje se razlikuju samo
+ * po imenima promenljivih i poretku literala
+ *
+ * @details Zapis je niz brojeva u prefiksnom poretku: za svaki literal njegov znak, pa
+ * simbol i arnost atoma i argumenata, a promenljiva se zapisuje kao VariableArity i redni
+ * broj njenog prvog pojavljivanja u klauzi. Literali se pre numerisanja uredjuju po obliku
+ * u kome su sve promenljive iste, pa preimenovanje ne menja poredak. Literali istog oblika
+ * ostaju u zatecenom poretku, pa se retko poneka varijanta ne prepozna, sto je bezbedno.
+ */
+struct ClauseVariant
+{
+    std::vector<std::uint32_t> code;
+    std::size_t hash;
+
+    inline bool operator==(const ClauseVariant &oth) const { return hash == oth.hash && code == oth.code; }
+
+    struct Hash
+    {
+        inline std::size_t operator()(const ClauseVariant &v) const { return v.hash; }
+    };
+};
+
+/**
+ * @brief encodeTerm - dopisuje kod terma 't' procitanog pod okruzenjem 'env'
+ * @param vars - promenljive redom prvog pojavljivanja, za nullptr sve promenljive imaju isti kod
+ */
+static void encodeTerm(const Term &t, const Substitution *env, std::vector<Variable> *vars, std::vector<std::uint32_t> &code)
+{
+    /* Vrednost iz okruzenja je konkretan term, pa se dalje cita bez okruzenja */
+    Term r = deref(t, env);
+    if (r != t)
+    {
+        env = nullptr;
+    }
+
+    if (r->kind() == BaseTerm::Kind::Variable)
+    {
+        std::uint32_t number = 0;
+        if (vars)
+        {
+            const Variable &v = static_cast<const VariableTerm*>(r.get())->variable();
+            auto it = std::find(vars->cbegin(), vars->cend(), v);
+            number = static_cast<std::uint32_t>(it - vars->cbegin());
+            if (it == vars->cend())
+            {
+                vars->push_back(v);
+            }
+        }
+        code.push_back(FlatCell::VariableArity);
+        code.push_back(number);
+        return;
+    }
+
+    const FunctionTerm *f = static_cast<const FunctionTerm*>(r.get());
+    code.push_back(f->symbol().id());
+    code.push_back(static_cast<std::uint32_t>(f->operands().size()));
+    for (const Term &op : f->operands())
+    {
+        encodeTerm(op, env, vars, code);
+    }
+}
+
+static void encodeLiteral(const LazyLiteral &l, std::vector<Variable> *vars, std::vector<std::uint32_t> &code)
+{
+    const Atom *a = l.literal.atom();
+    code.push_back(l.literal.negated() ? 1 : 0);
+    code.push_back(a->symbol().id());
+    code.push_back(static_cast<std::uint32_t>(a->getArity()));
+    for (const Term &op : a->operands())
+    {
+        encodeTerm(op, l.env, vars, code);
+    }
+}
+
+/**
+ * @brief clauseVariant - kanonski zapis klauze, ponovljeni literali se zapisuju jednom
+ */
+static ClauseVariant clauseVariant(const LazyClause &c)
+{
+    std::vector<std::pair<std::vector<std::uint32_t>, size_t>> shapes;
+    shapes.reserve(c.size());
+    for (size_t i = 0; i < c.size(); ++i)
+    {
+        bool repeated = false;
+        for (size_t j = 0; j < i && !repeated; ++j)
+        {
+            repeated = literalsEqualUnder(c[j].literal, c[j].env, c[i].literal, c[i].env);
+        }
+        if (!repeated)
+        {
+            shapes.emplace_back(std::vector<std::uint32_t>(), i);
+            encodeLiteral(c[i], nullptr, shapes.back().first);
+        }
+    }
+    std::stable_sort(shapes.begin(), shapes.end(), [](const auto &l, const auto &r) { return l.first < r.first; });
+
+    ClauseVariant variant;
+    std::vector<Variable> vars;
+    for (const auto &s : shapes)
+    {
+        encodeLiteral(c[s.second], &vars, variant.code);
+    }
+    variant.hash = variant.code.size();
+    for (std::uint32_t x : variant.code)
+    {
+        variant.hash = hashCombine(variant.hash, x);
+    }
+    return variant;
+}
+
+/**
+ * @brief ClauseState - stanje klauze u petlji izabrane klauze
+ */
+enum class ClauseState : std::uint8_t
+{
+    Passive,
+    Active,
+    Deleted
+};
+
+/**
+ * @brief ClauseSet - radni skup klauza rezolucije zajedno sa indeksima nad njim
+ *
+ * @details Na klauze se pozivamo njihovim indeksima u nizu, pa se sadrzana klauza ne brise
+ * iz niza, vec se oznacava kao obrisana i izbacuje iz indeksa. Indeks osobina sadrzi sve
+ * zadrzane klauze (aktivne i pasivne), a diskriminaciono stablo samo literale aktivnih klauza,
+ * jer se rezolvira samo sa njima. Skup 'variants' pamti varijante svih do sada razmotrenih
+ * klauza, zadrzanih i odbacenih: odbacena klauza je tautologija ili je sadrzana u nekoj
+ * klauzi skupa, pa je takva i svaka njena varijanta.
+ */
+struct ClauseSet
+{
+    explicit ClauseSet(const ResolutionOptions &options)
+        : limits(options.limits),
+          cancellation(options.cancellation),
+          start(std::chrono::steady_clock::now()),
+          passive(options.pickGivenRatio),
+          selection(options.inference == ResolutionOptions::Inference::Hyper
+                    ? ResolutionOptions::Selection::AllNegative : options.selection),
+          inference(options.inference),
+          binary(options.inference != ResolutionOptions::Inference::Hyper),
+          unitPreference(options.unitPreference)
+    {
+        /* UR rezolucija je potpuna za Hornove klauze samo bez ogranicenja izvodjenja */
+        if (inference == ResolutionOptions::Inference::UnitResulting)
+        {
+            selection = ResolutionOptions::Selection::None;
+            return;
+        }
+        switch (options.ordering)
+        {
+        case ResolutionOptions::Ordering::KBO:
+            ordering.reset(new KnuthBendixOrdering());
+            break;
+        case ResolutionOptions::Ordering::LPO:
+            ordering.reset(new LexicographicPathOrdering());
+            break;
+        case ResolutionOptions::Ordering::None:
+            break;
+        }
+    }
+
+    const ResolutionOptions::Limits limits;
+    const CancellationToken *cancellation;
+    const std::chrono::steady_clock::time_point start;
+    /* Broj izvedenih klauza, ukljucujuci i odbacene */
+    std::size_t generated = 0;
+    /* Broj zadrzanih klauza, pasivnih i aktivnih; obrisane klauze ostaju u skladistu, ali se ne broje */
+    std::size_t kept = 0;
+    /* Da li je neka izvedena klauza odbacena zbog ogranicenja, pa zasicenje ne dokazuje zadovoljivost */
+    bool incomplete = false;
+    /* Da li je izvedena prazna klauza, rezolucija prekinuta ili dostignuto ogranicenje resursa */
+    bool stopped = false;
+
+    ClauseStore clauses;
+    std::vector<ClauseState> states;
+    /* Da li klauza pripada skupu podrske, bez te strategije pripadaju sve */
+    std::vector<bool> support;
+    /* Broj lokalnih promenljivih klauze */
+    std::vector<std::uint32_t> variableCount;
+    /* Termovi promenljivih po bankama, da se ne bi trazili u Factory-ju pri svakom izvodjenju */
+    std::vector<std::vector<Term>> bankTerms;
+    /* Literali aktivne klauze na kojima su dozvoljena izvodjenja */
+    std::vector<std::vector<bool>> eligible;
+    FeatureVectorIndex features;
+    DiscriminationTree literals;
+    std::unordered_set<ClauseVariant, ClauseVariant::Hash> variants;
+    PassiveQueue passive;
+    /* Uredjenje atoma, nullptr ako su izvodjenja neogranicena */
+    std::unique_ptr<TermOrdering> ordering;
+    ResolutionOptions::Selection selection;
+    ResolutionOptions::Inference inference;
+    /* Da li se vrsi i binarna rezolucija, kod UR rezolucije samo ako ulaz nije Hornov */
+    bool binary;
+    /* Da li su sve ulazne klauze Hornove */
+    bool horn = true;
+    bool unitPreference;
+    /* Da li je izvedena prazna klauza */
+    bool refuted = false;
+};
+
+/**
+ * @brief seenVariant - da li je varijanta klauze 'c' vec razmotrena, ako nije pamti se
+ * @details Klauze iz skupa podrske i van njega se ne smatraju varijantama jedna druge, jer
+ * odbacivanje klauze iz skupa podrske zbog aksiome moze da ukloni jedini put do pobijanja.
+ */
+static bool seenVariant(ClauseSet &set, const LazyClause &c, bool support)
+{
+    ClauseVariant variant = clauseVariant(c);
+    variant.code.push_back(support ? 1 : 0);
+    variant.hash = hashCombine(variant.hash, support ? 1 : 0);
+    return !set.variants.insert(std::move(variant)).second;
+}
+
+/**
+ * @brief canSubsume - da li klauza 'subsumer' sme da ukloni klauzu koju sadrzi
+ * @details Klauza van skupa podrske ne uklanja klauze iz skupa podrske.
+ */
+static inline bool canSubsume(const ClauseSet &set, unsigned subsumer, bool support)
+{
+    return !support || set.support[subsumer];
+}
+
+/**
+ * @brief bankTerm - term promenljive sa lokalnim indeksom 'index' u banci 'bank'
+ */
+static const Term& bankTerm(ClauseSet &set, unsigned bank, unsigned index)
+{
+    if (bank >= set.bankTerms.size())
+    {
+        set.bankTerms.resize(bank + 1);
+    }
+    std::vector<Term> &terms = set.bankTerms[bank];
+    while (terms.size() <= index)
+    {
+        terms.push_back(Factory::make<VariableTerm>(bankVariable(bank, static_cast<unsigned>(terms.size()))));
+    }
+    return terms[index];
+}
+
+/**
+ * @brief bankEnvironment - dopunjuje okruzenje premise iz banke 'bank' sa 'count' promenljivih,
+ * tako da se i nevezane promenljive citaju kao promenljive te banke
+ */
+static void bankEnvironment(ClauseSet &set, Substitution &env, unsigned bank, std::uint32_t count)
+{
+    for (unsigned k = 0; k < count; ++k)
+    {
+        const Variable v = bankVariable(0, k);
+        auto it = env.lower_bound(v);
+        if (it == env.end() || it->first != v)
+        {
+            env.emplace_hint(it, v, bankTerm(set, bank, k));
+        }
+    }
+}
+
+static void collectVariables(const Term &t, std::vector<Variable> &vars)
+{
+    if (t->isGround())
+    {
+        return;
+    }
+    if (t->kind() == BaseTerm::Kind::Variable)
+    {
+        const Variable &v = static_cast<const VariableTerm*>(t.get())->variable();
+        if (std::find(vars.cbegin(), vars.cend(), v) == vars.cend())
+        {
+            vars.push_back(v);
+        }
+        return;
+    }
+    for (const Term &op : static_cast<const FunctionTerm*>(t.get())->operands())
+    {
+        collectVariables(op, vars);
+    }
+}
+
+/**
+ * @brief localizeVariables - preimenuje promenljive klauze u lokalne promenljive banke 0,
+ * redom pojavljivanja, pa se premise izvodjenja razdvajaju samo izborom banke
+ * @return broj promenljivih klauze
+ */
+static std::uint32_t localizeVariables(ClauseSet &set, std::vector<ClauseLiteral> &c)
+{
+    std::vector<Variable> vars;
+    for (const ClauseLiteral &l : c)
+    {
+        for (const Term &op : l.atom()->operands())
+        {
+            collectVariables(op, vars);
+        }
+    }
+
+    Substitution renaming;
+    for (unsigned k = 0; k < vars.size(); ++k)
+    {
+        const Term &local = bankTerm(set, 0, k);
+        if (static_cast<const VariableTerm*>(local.get())->variable() != vars[k])
+        {
+            renaming[vars[k]] = local;
+        }
+    }
+    if (!renaming.empty())
+    {
+        /* Supstitucija je simultana, pa je ispravna i kada dve lokalne promenljive menjaju mesta */
+        for (ClauseLiteral &l : c)
+        {
+            l = l.substitute(renaming);
+        }
+    }
+    return static_cast<std::uint32_t>(vars.size());
+}
+
+/**
+ * @brief Binding - vezivanje promenljive klauze koja sadrzi za podterm klauze koja je sadrzana,
+ * procitan pod okruzenjem 'env'
+ */
+struct Binding
+{
+    Variable variable;
+    Term term;
+    const Substitution *env;
+};
+
+using Bindings = std::vector<Binding>;
+
+/**
+ * @brief matchUnder - jednosmerno uparivanje terma 'pattern' sa termom 't' procitanim pod okruzenjem 'env'
+ * @details Vezivanja se samo dodaju na kraj, pa ih pozivalac ponistava vracanjem duzine niza.
+ */
+static bool matchUnder(const Term &pattern, const Term &t, const Substitution *env, Bindings &bindings)
+{
+    if (pattern->isGround())
+    {
+        return equalUnder(pattern, nullptr, t, env);
+    }
+    
+    if (pattern->kind() == BaseTerm::Kind::Variable)
+    {
+        const Variable &v = static_cast<const VariableTerm*>(pattern.get())->variable();
+        for (const Binding &b : bindings)
+        {
+            if (b.variable == v)
+            {
+                return equalUnder(b.term, b.env, t, env);
+            }
+        }
+        bindings.push_back({v, t, env});
+        return true;
+    }
+    
+    /* Vrednost iz okruzenja je konkretan term, pa se dalje cita bez okruzenja */
+    Term r = deref(t, env);
+    if (r != t)
+    {
+        env = nullptr;
+    }
+    if (r->kind() != BaseTerm::Kind::Function)
+    {
+        return false;
+    }
+    
+    const FunctionTerm *pf = static_cast<const FunctionTerm*>(pattern.get());
+    const FunctionTerm *rf = static_cast<const FunctionTerm*>(r.get());
+    if (pf->symbol() != rf->symbol() || pf->operands().size() != rf->operands().size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < pf->operands().size(); ++i)
+    {
+        if (!matchUnder(pf->operands()[i], rf->operands()[i], env, bindings))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief matchLiteral - uparivanje literala istog znaka i simbola
+ */
+static bool matchLiteral(const ClauseLiteral &pattern, const LazyLiteral &l, Bindings &bindings)
+{
+    const Atom *pa = pattern.atom();
+    const Atom *la = l.literal.atom();
+    for (size_t i = 0; i < pa->operands().size(); ++i)
+    {
+        if (!matchUnder(pa->operands()[i], la->operands()[i], l.env, bindings))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief SubsumptionProblem - literali klauze koja sadrzi, uredjeni po selektivnosti,
+ * sa pozicijama literala druge klauze sa kojima se mogu upariti
+ */
+struct SubsumptionProblem
+{
+    std::vector<std::pair<const ClauseLiteral*, std::vector<size_t>>> literals;
+    std::vector<bool> used;
+};
+
+static bool subsumesFrom(SubsumptionProblem &p, size_t level, const LazyClause &d, Bindings &bindings)
+{
+    if (level == p.literals.size())
+    {
+        return true;
+    }
+    
+    const ClauseLiteral &l = *p.literals[level].first;
+    for (size_t j : p.literals[level].second)
+    {
+        if (p.used[j])
+        {
+            continue;
+        }
+        
+        size_t mark = bindings.size();
+        if (matchLiteral(l, d[j], bindings))
+        {
+            p.used[j] = true;
+            if (subsumesFrom(p, level + 1, d, bindings))
+            {
+                return true;
+            }
+            p.used[j] = false;
+        }
+        bindings.resize(mark);
+    }
+    return false;
+}
+
+/**
+ * @brief subsumes - provera da li klauza 'c' sadrzi (theta-subsumira) klauzu 'd'
+ * @details Trazi se supstitucija 'σ' tako da su razliciti literali klauze σ(c) razliciti
+ * literali klauze 'd'. Uparivanje je injektivno (kao nad multiskupovima), pa klauza
+ * ne sadrzi svoje faktore. Literali klauze 'c' se uparuju od onih sa najmanje kandidata,
+ * a pretraga se vraca unazad kada uparivanje ne uspe.
+ */
+static bool subsumes(const ClauseView &c, const LazyClause &d)
+{
+    /* Ponovljeni literali klauze 'd' se ne uzimaju kao kandidati, kao sto se ni ne broje u osobinama */
+    std::vector<bool> repeated(d.size(), false);
+    for (size_t i = 0; i < d.size(); ++i)
+    {
+        for (size_t j = 0; j < i && !repeated[i]; ++j)
+        {
+            repeated[i] = !repeated[j] && literalsEqualUnder(d[j].literal, d[j].env, d[i].literal, d[i].env);
+        }
+    }
+    
+    SubsumptionProblem p;
+    p.used.assign(d.size(), false);
+    /* Klauza iz skladista nema ponovljenih literala */
+    for (const ClauseLiteral &l : c)
+    {
+        const Atom *a = l.atom();
+        std::vector<size_t> candidates;
+        for (size_t j = 0; j < d.size(); ++j)
+        {
+            const Atom *b = d[j].literal.atom();
+            if (!repeated[j] && l.negated() == d[j].literal.negated() &&
+                a->symbol() == b->symbol() && a->getArity() == b->getArity())
+            {
+                candidates.push_back(j);
+            }
+        }
+        if (candidates.empty())
+        {
+            return false;
+        }
+        p.literals.emplace_back(&l, std::move(candidates));
+    }
+    
+    /* Najselektivniji literali (najmanje kandidata, pa vece atome) uparujemo prvo */
+    std::stable_sort(p.literals.begin(), p.literals.end(), [](const auto &l, const auto &r)
+    {
+        if (l.second.size() != r.second.size())
+        {
+            return l.second.size() < r.second.size();
+        }
+        return l.first->atom()->size() > r.first->atom()->size();
+    });
+    
+    Bindings bindings;
+    return subsumesFrom(p, 0, d, bindings);
+}
+
+/**
+ * @brief concrete - klauza kao niz literala bez okruzenja
+ */
+static LazyClause concrete(const ClauseView &c)
+{
+    LazyClause lc;
+    lc.reserve(c.size());
+    for (const auto &l : c)
+    {
+        lc.push_back({l, nullptr});
+    }
+    return lc;
+}
+
+/**
+ * @brief clauseWeight - tezina klauze za izbor iz pasivnog skupa: ukupan broj simbola
+ * @details Uz prednost jedinicnih klauza, nejedinicnim klauzama se postavlja najvisi bit
+ * tezine, pa je svaka jedinicna klauza laksa od svake nejedinicne.
+ */
+static std::uint32_t clauseWeight(const ClauseSet &set, const ClauseView &c)
+{
+    std::uint32_t weight = 0;
+    for (const ClauseLiteral &l : c)
+    {
+        weight += static_cast<std::uint32_t>(l.atom()->size());
+    }
+    if (set.unitPreference && c.size() > 1)
+    {
+        weight |= std::uint32_t(1) << 31;
+    }
+    return weight;
+}
+
+/**
+ * @brief eligibleLiterals - literali klauze na kojima su dozvoljena izvodjenja
+ *
+ * @details Ako funkcija izbora izabere neke negativne literale, izvodjenja su samo na njima.
+ * Inace su dozvoljeni literali koji nisu manji od nekog drugog literala klauze. Uredjenje je
+ * stabilno u odnosu na supstitucije, pa literal koji je manji od nekog drugog ne moze biti
+ * maksimalan ni posle primene unifikatora i bezbedno se odbacuje pre unifikacije.
+ */
+static std::vector<bool> eligibleLiterals(const ClauseSet &set, const ClauseView &c)
+{
+    std::vector<bool> eligible(c.size(), false);
+    switch (set.selection)
+    {
+    case ResolutionOptions::Selection::AllNegative:
+        for (size_t k = 0; k < c.size(); ++k)
+        {
+            eligible[k] = c[k].negated();
+        }
+        break;
+    case ResolutionOptions::Selection::LargestNegative:
+    {
+        size_t best = c.size();
+        for (size_t k = 0; k < c.size(); ++k)
+        {
+            if (c[k].negated() && (best == c.size() || c[k].atom()->size() > c[best].atom()->size()))
+            {
+                best = k;
+            }
+        }
+        if (best != c.size())
+        {
+            eligible[best] = true;
+        }
+        break;
+    }
+    case ResolutionOptions::Selection::None:
+        break;
+    }
+    if (std::find(eligible.cbegin(), eligible.cend(), true) != eligible.cend())
+    {
+        return eligible;
+    }
+
+    for (size_t k = 0; k < c.size(); ++k)
+    {
+        eligible[k] = true;
+        for (size_t m = 0; m < c.size() && set.ordering && eligible[k]; ++m)
+        {
+            eligible[k] = m == k || set.ordering->compare(c[k].atom(), c[m].atom()) != Comparison::Less;
+        }
+    }
+    return eligible;
+}
+
+static void removeClause(ClauseSet &set, unsigned idx)
+{
+    const ClauseView c = set.clauses[idx];
+    if (set.states[idx] == ClauseState::Active)
+    {
+        for (size_t k = 0; k < c.size(); ++k)
+        {
+            set.literals.remove(c[k].atom(), c[k].negated(), {idx, static_cast<std::uint32_t>(k)});
+        }
+    }
+    else
     {
-        return {};
+        set.passive.remove(idx);
     }
-    
-    TermPairs tpairs;
-    const std::vector<Term> &ops1 = a1->operands();
-    const std::vector<Term> &ops2 = a2->operands();
-    tpairs.reserve(ops1.size());
-    for (size_t i = 0; i < ops1.size(); ++i)
+    set.features.remove(clauseFeatures(c), idx);
+    set.states[idx] = ClauseState::Deleted;
+    --set.kept;
+}
+
+/**
+ * @brief addClause - dodaje novu klauzu u skup pasivnih klauza
+ */
+static void addClause(ClauseSet &set, std::vector<ClauseLiteral> literals, bool support)
+{
+    set.variableCount.push_back(localizeVariables(set, literals));
+    const std::uint32_t idx = set.clauses.add(std::move(literals));
+    const ClauseView c = set.clauses[idx];
+    set.states.push_back(ClauseState::Passive);
+    set.support.push_back(support);
+    set.features.insert(clauseFeatures(c), idx);
+    set.passive.push(idx, clauseWeight(set, c));
+    ++set.kept;
+    if (c.empty())
     {
-        tpairs.emplace_back(ops1[i], ops2[i]);
+        /* Ishod je poznat, pa se preostala izvodjenja izabrane klauze prekidaju */
+        set.refuted = true;
+        set.stopped = true;
     }
-    return unify(tpairs);
 }
 
-static bool clauseExists(const CNF &cnf, const Clause &c)
+static bool clauseExists(const ClauseSet &set, const LazyClause &c, bool support)
 {
     /**
      * Uslov koji nas zanima je malo labaviji nego da postoji bas takva klauza 'c'
@@ -38,24 +822,16 @@ static bool clauseExists(const CNF &cnf, const Clause &c)
      * kao novu klauzu. Ako je c2 zadovoljena to znaci da je bar jedan od literala p, q
      * tacan, sto dalje dovodi do toga da je c1 takodje zadovoljena. Klauza c1 nam 
      * ne daje nikakve nove restrikcije i nema smisla da je dodajemo (mozemo reci da
-     * je c2 sadrzana u c1).
+     * je c2 sadrzana u c1). Isto vazi i ako je neka instanca klauze c2 sadrzana u c1,
+     * na primer za c2 = (p(x) \/ q(x)) i c1 = (p(a) \/ q(a) \/ r).
      */
     
-    /* Za sve klauze posmatrane formule proveravamo sadrzanost sa prosledjenom klauzom */
-    for (const auto &c1 : cnf)
+    /* Proveravamo samo klauze cije osobine dozvoljavaju da su sadrzane u 'c' */
+    std::vector<std::uint32_t> candidates;
+    set.features.subsuming(clauseFeatures(c), candidates);
+    for (std::uint32_t idx : candidates)
     {
-        /* Ako se svi literali 'c1' nalaze u 'c' smatramo da klauza vec postoji */
-        bool subsumed = true;
-        for (const auto &l : c1)
-        {
-            if (std::find(c.cbegin(), c.cend(), l) == c.cend())
-            {
-                subsumed = false;
-                break;
-            }
-        }
-        
-        if (subsumed)
+        if (canSubsume(set, idx, support) && subsumes(set.clauses[idx], c))
         {
             return true;
         }
@@ -63,280 +839,747 @@ static bool clauseExists(const CNF &cnf, const Clause &c)
     return false;
 }
 
-static bool clauseTautology(const Clause &c)
+static bool clauseTautology(const LazyClause &c)
 {
-    /* Klauze ja tautologija ako sadrzi suprotne literale */
-    for (const auto &l : c)
+    /**
+     * Klauze ja tautologija ako sadrzi suprotne literale, tj. atom i negaciju istog atoma.
+     * Komplementi se ovde javljaju tek pod okruzenjem, pa se ne mogu naci jednim prolazom
+     * kroz uredjene literale kao u skladistu.
+     */
+    for (size_t i = 0; i < c.size(); ++i)
     {
-        /* Ako je u pitanju atom, trazimo njegovu negaciju, inace operand Not-a */
-        Formula opositeL;
-        const Atom *a = dynamic_cast<const Atom*>(l.get());
-        if (a)
-        {
-            opositeL = std::make_shared<Not>(l);
-        }
-        else
+        for (size_t j = i + 1; j < c.size(); ++j)
         {
-            opositeL = static_cast<const Not*>(l.get())->operand();
+            if (c[i].literal.negated() != c[j].literal.negated() &&
+                atomsEqualUnder(c[i].literal.atom(), c[i].env, c[j].literal.atom(), c[j].env))
+            {
+                return true;
+            }
         }
-        
-        if (c.cend() != std::find(c.cbegin(), c.cend(), opositeL))
+    }
+    return false;
+}
+
+/**
+ * @brief withinLimits - da li klauza postuje ogranicenja dubine terma i tezine
+ */
+static bool withinLimits(const ClauseSet &set, const std::vector<ClauseLiteral> &c)
+{
+    unsigned weight = 0;
+    for (const ClauseLiteral &l : c)
+    {
+        weight += l.atom()->size();
+        for (const Term &op : l.atom()->operands())
         {
-            return true;
+            if (set.limits.termDepth && op->depth() > set.limits.termDepth)
+            {
+                return false;
+            }
         }
     }
-    return false;
+    return !set.limits.clauseWeight || weight <= set.limits.clauseWeight;
+}
+
+/**
+ * @brief limitReached - da li je rezolucija prekinuta ili je dostignuto ogranicenje resursa
+ * @details Proverava se pre izbora svake klauze i pre svake izvedene klauze, pa izvodjenja
+ * jedne izabrane klauze ne mogu dugo da prekorace ogranicenje. Jednom postavljen prekid ostaje.
+ */
+static bool limitReached(ClauseSet &set)
+{
+    const ResolutionOptions::Limits &limits = set.limits;
+    set.stopped = set.stopped ||
+        (set.cancellation && set.cancellation->cancelled()) ||
+        (limits.generated && set.generated >= limits.generated) ||
+        (limits.kept && set.kept >= limits.kept) ||
+        (limits.memory &&
+         Region::current()->bytesReserved() + set.clauses.literalCount() * sizeof(ClauseLiteral) >= limits.memory) ||
+        (limits.time.count() && std::chrono::steady_clock::now() - set.start >= limits.time);
+    return set.stopped;
 }
 
-static bool tryGroupLiterals(CNF &cnf, unsigned idx)
+/**
+ * @brief keepDerived - dodaje izvedenu klauzu u pasivni skup ako nije suvisna
+ * @details Ako je klauza varijanta vec razmotrene, vec postoji ili je tautologija nas skup
+ * klauza se sustinski ne menja. Izvodjenjem se cesto dobijaju preimenovane kopije iste
+ * klauze, pa se one odbacuju pre skupljih provera. Klauza koja prelazi ogranicenja se
+ * odbacuje tek kada se zna da nije suvisna, jer samo tada menja ishod.
+ */
+static void keepDerived(ClauseSet &set, const LazyClause &c, bool support)
+{
+    if (limitReached(set))
+    {
+        return;
+    }
+    ++set.generated;
+    if (seenVariant(set, c, support) || clauseTautology(c) || clauseExists(set, c, support))
+    {
+        return;
+    }
+
+    std::vector<ClauseLiteral> literals = materialize(c);
+    ClauseStore::normalize(literals);
+    if (!withinLimits(set, literals))
+    {
+        set.incomplete = true;
+        return;
+    }
+    addClause(set, std::move(literals), support);
+}
+
+/**
+ * @brief tryGroupLiterals - dodaje u pasivni skup sve faktore klauze 'idx'
+ */
+static void tryGroupLiterals(ClauseSet &set, unsigned idx, UnifierCache &cache)
 {
     /**
-     * Trudimo se da unifikujemo sve parove literala klauze, zato
-     * definisemo promenljive da je i-ti literal atom 'ai', da je
-     * i-ti literal negacija atoma 'ni' i sl.
+     * Trudimo se da unifikujemo sve parove literala klauze istog znaka. Uz uredjenje se
+     * grupisu samo pozitivni literali, od kojih bar jedan mora biti dozvoljen.
      */
-    bool ret = false;
-    Clause &c = cnf[idx];
-    Atom *ai = nullptr, *aj = nullptr;
-    Not *ni = nullptr, *nj = nullptr;
-    
+    /* Kopija, jer dodavanje novih klauza u skladiste invalidira pogled na klauzu */
+    const ClauseView view = set.clauses[idx];
+    const std::vector<ClauseLiteral> c(view.begin(), view.end());
+    const std::vector<bool> &eligible = set.eligible[idx];
+    /* Faktor je u skupu podrske ako je i sama klauza */
+    const bool support = set.support[idx];
+    const bool ordered = set.ordering || set.selection != ResolutionOptions::Selection::None;
+
     /**
      * Za sve parove literala ukoliko su istog tipa trudimo se da ih unifikujemo
      * */
-    for (size_t i = 0; i < c.size(); ++i)
+    for (size_t i = 0; i < c.size() && !set.stopped; ++i)
     {
-        /* Ako dinamicko kastovanje u Atom* nije uspelo, znaci da je literal sigurno Not */
-        ai = dynamic_cast<Atom*>(c[i].get());
-        ni = !ai ? static_cast<Not*>(c[i].get()) : nullptr;
         for (size_t j = i+1; j < c.size(); ++j)
         {
-            /* Ako dinamicko kastovanje u Atom* nije uspelo, znaci da je literal sigurno Not */
-            aj = dynamic_cast<Atom*>(c[j].get());
-            nj = !aj ? static_cast<Not*>(c[j].get()) : nullptr;
-            OptionalSubstitution s;
-            if (ai && aj)
-            {
-                s = unify(ai, aj);
-            }
-            else if (ni && nj)
+            if (c[i].negated() != c[j].negated() ||
+                (ordered && (c[i].negated() || !(eligible[i] || eligible[j]))))
             {
-                s = unify(static_cast<Atom*>(ni->operand().get()), 
-                          static_cast<Atom*>(nj->operand().get()));
+                continue;
             }
-            
-            /** 
-             * Ako su unifikabilni izbacujemo jedan od dva literala, a na sve ostale 
-             * primenjujemo supstituciju 
+            OptionalSubstitution s = cache.unify(c[i].atom(), c[j].atom());
+
+            /**
+             * Ako su unifikabilni izbacujemo jedan od dva literala, a na sve ostale
+             * primenjujemo supstituciju
              */
             if (s)
             {
-                Clause cCpy = cnf[idx];
-                std::swap(cCpy[j], cCpy.back());
-                cCpy.pop_back();
-                for (auto &l : cCpy)
+                LazyClause cCpy;
+                cCpy.reserve(c.size() - 1);
+                for (size_t k = 0; k < c.size(); ++k)
                 {
-                    l = l->substitute(s.value());
-                }
-                
-                /* Ako klauza vec postoji ili je tautologija nas skup klauza se sustinski ne menja */
-                if (!clauseExists(cnf, cCpy) && !clauseTautology(cCpy))
-                {
-                    cnf.push_back(cCpy);
-                    ret = true;
+                    if (k != j)
+                    {
+                        cCpy.push_back({c[k], &s.value()});
+                    }
                 }
+
+                keepDerived(set, cCpy, support);
             }
         }
     }
-    
-    return ret;
 }
 
-static bool grouping(CNF &cnf, unsigned &idxLastGrpCl)
+/**
+ * @brief tryResolveClauses - dodaje u pasivni skup sve rezolvente klauza 'i' i 'j'
+ */
+static void tryResolveClauses(ClauseSet &set, unsigned i, unsigned j, BatchUnifier &batch)
 {
+    /* Bar jedan roditelj mora biti iz skupa podrske, i tada je i rezolventa u njemu */
+    if (!set.support[i] && !set.support[j])
+    {
+        return;
+    }
+
+    /* Kopije, jer dodavanje novih klauza u skladiste invalidira poglede na klauze */
+    const ClauseView vi = set.clauses[i], vj = set.clauses[j];
+    const std::vector<ClauseLiteral> ci(vi.begin(), vi.end());
+    const std::vector<ClauseLiteral> cj(vj.begin(), vj.end());
+
     /**
-     * Na sve klauze pocevsi od poslednje za koju smo to vec radili,
-     * trudimo se da primenimo grupisanje
+     * Klauza 'i' se cita u banci 0, a klauza 'j' u banci 1, pa su promenljive premisa
+     * razdvojene bez preimenovanja, i kada se klauza rezolvira sama sa sobom
      */
-    bool ret = false;
-    while (idxLastGrpCl < cnf.size()) 
+
+    /**
+     * Dozvoljene literale klauze 'j' delimo na dva niza atoma, pozitivne i negirane, pa se svaki
+     * dozvoljen literal klauze 'i' unifikuje u jednom prolazu sa svim literalima suprotnog znaka
+     */
+    AtomBatch positive, negative;
+    std::vector<size_t> positivePos, negativePos;
+    for (size_t l = 0; l < cj.size(); ++l)
+    {
+        if (!set.eligible[j][l])
+        {
+            continue;
+        }
+        if (cj[l].negated())
+        {
+            negative.push_back(cj[l].atom());
+            negativePos.push_back(l);
+        }
+        else
+        {
+            positive.push_back(cj[l].atom());
+            positivePos.push_back(l);
+        }
+    }
+
+    for (size_t k = 0; k < ci.size() && !set.stopped; ++k)
     {
-        if (tryGroupLiterals(cnf, idxLastGrpCl++))
+        if (!set.eligible[i][k])
+        {
+            continue;
+        }
+
+        /* Atom literala se unifikuje sa atomima suprotnog znaka */
+        const AtomBatch &candidates = ci[k].negated() ? positive : negative;
+        const std::vector<size_t> &positions = ci[k].negated() ? positivePos : negativePos;
+        if (candidates.empty())
         {
-            ret = true;
+            continue;
+        }
+
+        /* Za svaki kandidat sa kojim je unifikacija uspela */
+        for (const BatchUnifier::Result &r : batch.unify(ci[k].atom(), candidates, 1))
+        {
+            const size_t l = positions[r.index];
+            Substitution envJ = r.candidateMgu;
+            bankEnvironment(set, envJ, 1, set.variableCount[j]);
+
+            /* Rezolventu cine preostali literali obe klauze, citani pod okruzenjima svojih banaka */
+            LazyClause resolvent;
+            resolvent.reserve(ci.size() + cj.size() - 2);
+            for (size_t m = 0; m < ci.size(); ++m)
+            {
+                if (m != k)
+                {
+                    resolvent.push_back({ci[m], &r.mgu});
+                }
+            }
+            for (size_t m = 0; m < cj.size(); ++m)
+            {
+                if (m != l)
+                {
+                    resolvent.push_back({cj[m], &envJ});
+                }
+            }
+
+            keepDerived(set, resolvent, true);
         }
     }
-    return ret;
 }
 
-static void getClauseVars(const Clause &c, VariablesSet &vset)
+/**
+ * @brief isElectron - da li klauza moze biti elektron: pozitivna klauza kod hiperrezolucije,
+ * a jedinicna kod UR rezolucije
+ */
+static bool isElectron(const ClauseSet &set, const ClauseView &c)
 {
-    for (const auto & l: c)
+    if (set.inference == ResolutionOptions::Inference::UnitResulting)
     {
-        l->getVars(vset);
+        return c.size() == 1;
     }
+    return std::none_of(c.begin(), c.end(), [](const ClauseLiteral &l) { return l.negated(); });
 }
 
-static bool clauseHasVar(const Clause &c, const Variable &v)
+/**
+ * @brief NucleusSearch - stanje pretrage elektrona za literale jezgra
+ */
+struct NucleusSearch
+{
+    /* Kopija jezgra, jer dodavanje klauza u skladiste invalidira pogled na njega */
+    std::vector<ClauseLiteral> nucleus;
+    /* Literali jezgra koji se rezolviraju i aktivni elektroni sa komplementarnim literalom za svaki */
+    std::vector<size_t> targets;
+    std::vector<std::vector<DiscriminationTree::Entry>> electrons;
+    /* Najveci broj literala iz 'targets' koji ostaju u zakljucku */
+    size_t maxKept;
+    /* Pozicija u 'targets' literala koji se rezolvira sa izabranom klauzom, targets.size() ako ga nema */
+    size_t fixed;
+    unsigned given;
+    /* Preostali literali elektrona sa bankama, broj promenljivih elektrona po banci i zadrzani literali jezgra */
+    std::vector<std::pair<ClauseLiteral, unsigned>> rest;
+    std::vector<std::uint32_t> bankVariables;
+    std::vector<size_t> kept;
+    /**
+     * Jednakosti izabranih parova atoma: atom jezgra iz banke 0 i atom elektrona. Elektron
+     * izabran za 't'-ti literal se cita u banci t + 1, pa svako njegovo koriscenje ima
+     * sopstvene promenljive. Pri vracanju se par ponistava, a prethodni parovi ostaju.
+     */
+    Unifier unifier;
+    /* Da li je neki od roditelja iz skupa podrske */
+    bool supported;
+};
+
+/**
+ * @brief concludeNucleus - dodaje u pasivni skup zakljucak pod okruzenjima banaka 'envs'
+ */
+static void concludeNucleus(ClauseSet &set, const NucleusSearch &p, std::vector<Substitution> envs)
 {
-    VariablesSet vset;
-    getClauseVars(c, vset);
-    return vset.find(v) != vset.cend();
+    envs.resize(p.bankVariables.size());
+    for (unsigned bank = 1; bank < envs.size(); ++bank)
+    {
+        bankEnvironment(set, envs[bank], bank, p.bankVariables[bank]);
+    }
+
+    std::vector<bool> resolved(p.nucleus.size(), false);
+    for (size_t k : p.targets)
+    {
+        resolved[k] = true;
+    }
+    for (size_t k : p.kept)
+    {
+        resolved[k] = false;
+    }
+
+    LazyClause conclusion;
+    conclusion.reserve(p.nucleus.size() + p.rest.size());
+    for (size_t k = 0; k < p.nucleus.size(); ++k)
+    {
+        if (!resolved[k])
+        {
+            conclusion.push_back({p.nucleus[k], &envs[0]});
+        }
+    }
+    for (const auto &l : p.rest)
+    {
+        conclusion.push_back({l.first, &envs[l.second]});
+    }
+
+    keepDerived(set, conclusion, true);
 }
 
-static Variable getUniqueVar(const Clause &c1, const Clause &c2)
+/**
+ * @brief unifyPair - dodaje jednakost atoma jezgra 'a' i atoma elektrona 'b' iz banke 'bank'
+ * @return false ako je doslo do sukoba simbola (ciklus se otkriva tek na kraju pretrage)
+ */
+static bool unifyPair(NucleusSearch &p, const Atom *a, const Atom *b, unsigned bank)
 {
-    static unsigned s_UniqueCounter = 0U;
-    VariablesSet vset;
-    getClauseVars(c1, vset);
-    getClauseVars(c2, vset);
-    Variable unique;
-    do {
-        unique = "uv" + std::to_string(s_UniqueCounter++);
-    } while (vset.find(unique) != vset.cend());
-    return unique;
+    for (size_t i = 0; i < a->getArity(); ++i)
+    {
+        if (!p.unifier.unify(a->operands()[i], 0, b->operands()[i], bank))
+        {
+            return false;
+        }
+    }
+    return true;
 }
 
-static bool tryResolveClauses(CNF &cnf, unsigned i, unsigned j)
+/**
+ * @brief searchElectrons - bira elektrone za literale jezgra od 't'-tog nadalje
+ */
+static void searchElectrons(ClauseSet &set, NucleusSearch &p, size_t t)
 {
-    /* Obezbedjujemo korektno (pre)imenovanje promenljivih */
-    bool ret = false;
-    VariablesSet vset;
-    getClauseVars(cnf[i], vset);
-    for (const auto &v : vset)
+    if (t == p.targets.size())
     {
-        if (clauseHasVar(cnf[j], v))
+        std::vector<Substitution> envs;
+        if (p.supported && p.unifier.solve(envs))
         {
-            Variable renamed = getUniqueVar(cnf[i], cnf[j]);
-            for (auto &l : cnf[j])
-            {
-                l = l->substitute(v, std::make_shared<VariableTerm>(renamed));
-            }
+            concludeNucleus(set, p, std::move(envs));
         }
+        return;
     }
-    
-    /* Za sve parove literala klauza probamo da ih unifikujemo ako nisu istog tipa (Atom i Not) */
-    for (size_t k = 0; k < cnf[i].size(); ++k)
-    {
-        /* Ako dinamicko kastovanje u Atom* nije uspelo, znaci da je literal sigurno Not */
-        Atom *ai = dynamic_cast<Atom*>(cnf[i][k].get());
-        Not *ni = !ai ? static_cast<Not*>(cnf[i][k].get()) : nullptr;
-        for (size_t l = 0; l < cnf[j].size(); ++l)
-        {
-            /* Ako dinamicko kastovanje u Atom* nije uspelo, znaci da je literal sigurno Not */
-            Atom *aj = dynamic_cast<Atom*>(cnf[j][l].get());
-            Not *nj = !aj ? static_cast<Not*>(cnf[j][l].get()) : nullptr;
-            OptionalSubstitution s;
-            if (ai && nj)
+
+    if (p.kept.size() < p.maxKept && t != p.fixed)
+    {
+        p.kept.push_back(p.targets[t]);
+        searchElectrons(set, p, t + 1);
+        p.kept.pop_back();
+    }
+
+    const Atom *a = p.nucleus[p.targets[t]].atom();
+    const unsigned bank = static_cast<unsigned>(t + 1);
+    for (const auto &entry : p.electrons[t])
+    {
+        if (set.stopped)
+        {
+            return;
+        }
+
+        /* Literalima pre fiksiranog se ne dodeljuje izabrana klauza, da se zakljucci ne bi ponavljali */
+        const bool isGiven = entry.clause == p.given;
+        if (t < p.fixed ? isGiven : (t == p.fixed && !isGiven))
+        {
+            continue;
+        }
+
+        /* Kopija, jer dodavanje klauza u skladiste invalidira pogled na elektron */
+        const ClauseView view = set.clauses[entry.clause];
+        const std::vector<ClauseLiteral> e(view.begin(), view.end());
+        const Atom *b = e[entry.literal].atom();
+        if (a->symbol() != b->symbol() || a->getArity() != b->getArity())
+        {
+            continue;
+        }
+
+        const Unifier::Mark mark = p.unifier.mark();
+        if (unifyPair(p, a, b, bank))
+        {
+            const size_t restMark = p.rest.size();
+            for (size_t m = 0; m < e.size(); ++m)
             {
-                /* Unifikaciju vrsimo nad operandom Not-a */
-                s = unify(ai, static_cast<Atom*>(nj->operand().get()));
-                
+                if (m != entry.literal)
+                {
+                    p.rest.emplace_back(e[m], bank);
+                }
             }
-            else if (ni && aj)
+            p.bankVariables[bank] = set.variableCount[entry.clause];
+            const bool supported = p.supported;
+            p.supported = supported || set.support[entry.clause];
+            searchElectrons(set, p, t + 1);
+            p.supported = supported;
+            p.bankVariables[bank] = 0;
+            p.rest.erase(p.rest.begin() + restMark, p.rest.end());
+        }
+        p.unifier.undo(mark);
+    }
+}
+
+/**
+ * @brief resolveNucleus - dodaje u pasivni skup sve zakljucke jezgra 'nucleus' sa aktivnim elektronima
+ * @param fixedLiteral - literal jezgra koji se rezolvira sa izabranom klauzom 'given', ili
+ * velicina jezgra ako je jezgro sama izabrana klauza
+ */
+static void resolveNucleus(ClauseSet &set, unsigned nucleus, unsigned given, size_t fixedLiteral)
+{
+    NucleusSearch p;
+    const ClauseView view = set.clauses[nucleus];
+    p.nucleus.assign(view.begin(), view.end());
+    p.given = given;
+    p.supported = set.support[nucleus];
+
+    /* Hiperrezolucija rezolvira sve dozvoljene negativne literale, a UR sve literale osim jednog */
+    const bool unitResulting = set.inference == ResolutionOptions::Inference::UnitResulting;
+    for (size_t k = 0; k < p.nucleus.size(); ++k)
+    {
+        if (unitResulting || (set.eligible[nucleus][k] && p.nucleus[k].negated()))
+        {
+            if (k == fixedLiteral)
             {
-                /* Unifikaciju vrsimo nad operandom Not-a */
-                s = unify(static_cast<Atom*>(ni->operand().get()), aj);
+                p.fixed = p.targets.size();
             }
-            
-            /* Ako je unifikacija uspela */
-            if (s)
+            p.targets.push_back(k);
+        }
+    }
+    if (fixedLiteral == p.nucleus.size())
+    {
+        p.fixed = p.targets.size();
+    }
+    p.maxKept = unitResulting && p.targets.size() > 1 ? 1 : 0;
+
+    /* Kandidate za svaki literal trazimo unapred, pa se pretraga ne vraca u indeks */
+    p.electrons.resize(p.targets.size());
+    std::vector<DiscriminationTree::Entry> candidates;
+    for (size_t t = 0; t < p.targets.size(); ++t)
+    {
+        const ClauseLiteral &l = p.nucleus[p.targets[t]];
+        candidates.clear();
+        set.literals.unifiable(l.atom(), !l.negated(), candidates);
+        for (const auto &entry : candidates)
+        {
+            if (entry.clause != nucleus && isElectron(set, set.clauses[entry.clause]))
             {
-                /* Izbacujemo suprotne literale iz maticnih klauza */
-                Clause cnfCpyI = cnf[i];
-                Clause cnfCpyJ = cnf[j];
-                std::swap(cnfCpyI[k], cnfCpyI.back());
-                cnfCpyI.pop_back();
-                std::swap(cnfCpyJ[l], cnfCpyJ.back());
-                cnfCpyJ.pop_back();
-                
-                /* Kopiramo preostale literale iz obe klauze u rezolventu, 
-                 * primenjujuci supstituciju usput */
-                Clause resolvent;
-                resolvent.reserve(cnfCpyI.size() + cnfCpyJ.size());
-                std::transform(cnfCpyI.cbegin(), 
-                               cnfCpyI.cend(), 
-                               std::back_inserter(resolvent),
-                               [&](const Formula &l) {
-                    return l->substitute(s.value());
-                });
-                std::transform(cnfCpyJ.cbegin(), 
-                               cnfCpyJ.cend(), 
-                               std::back_inserter(resolvent),
-                               [&](const Formula &l) {
-                    return l->substitute(s.value());
-                });
-                
-                /* Ako je rezolventa tautologija ili smo vec izveli takvu klauzu ignorisemo je */
-                if (!clauseTautology(resolvent) && !clauseExists(cnf, resolvent))
-                {
-                    cnf.push_back(resolvent);
-                    ret = true;
-                }
+                p.electrons[t].push_back(entry);
             }
         }
+        /* Literal bez elektrona mora da ostane u zakljucku */
+        if (p.electrons[t].empty() && p.maxKept == 0)
+        {
+            return;
+        }
     }
-    
-    return ret;
+
+    p.bankVariables.assign(p.targets.size() + 1, 0);
+    searchElectrons(set, p, 0);
 }
 
-static bool resolventFound(CNF &cnf, unsigned &idxPrev, unsigned &idxCurr)
+/**
+ * @brief generateNucleus - izvodi sve zakljucke hiperrezolucije ili UR rezolucije u kojima
+ * ucestvuje izabrana klauza, kao jezgro ili kao elektron
+ */
+static void generateNucleus(ClauseSet &set, unsigned given)
 {
-    /* Za sve parove klauza za koje rezolucija nije primenjena do sada, primeni je*/
-    bool ret = false;
-    while (idxCurr < cnf.size())
+    const ClauseView c = set.clauses[given];
+    if (!isElectron(set, c))
     {
-        if (tryResolveClauses(cnf, idxPrev, idxCurr))
+        resolveNucleus(set, given, given, c.size());
+        return;
+    }
+
+    /* Jezgra sa literalom komplementarnim nekom dozvoljenom literalu izabrane klauze */
+    std::vector<DiscriminationTree::Entry> nuclei;
+    for (size_t k = 0; k < c.size(); ++k)
+    {
+        if (set.eligible[given][k])
         {
-            ret = true;
+            set.literals.unifiable(c[k].atom(), !c[k].negated(), nuclei);
         }
-        
-        /* Ako je prethodna klauza nije dosla do tekuce, pomeri indeks prethodne ka kraju */
-        if (idxPrev < idxCurr - 1)
+    }
+    std::sort(nuclei.begin(), nuclei.end(), [](const auto &l, const auto &r)
+    {
+        return l.clause != r.clause ? l.clause < r.clause : l.literal < r.literal;
+    });
+    nuclei.erase(std::unique(nuclei.begin(), nuclei.end()), nuclei.end());
+    for (const auto &entry : nuclei)
+    {
+        if (set.stopped)
         {
-            ++idxPrev;
+            return;
         }
-        else /* Inace, pomeri indeks tekuce klauze ka kraju i pocni ispocetka */
+
+        /* Kod hiperrezolucije elektron nije jezgro, a jedinicna klauza jeste jezgro UR rezolucije */
+        if (set.inference == ResolutionOptions::Inference::UnitResulting || !isElectron(set, set.clauses[entry.clause]))
         {
-            idxPrev = 0;
-            ++idxCurr;
+            resolveNucleus(set, entry.clause, given, entry.literal);
         }
     }
-    
-    return ret;
 }
 
-bool resolution(const CNF &cnf)
+/**
+ * @brief activate - uproscava izabranu klauzu i, ako nije suvisna, prebacuje je u aktivne
+ * @return false ako je izabrana klauza sadrzana u nekoj drugoj klauzi skupa
+ */
+static bool activate(ClauseSet &set, unsigned given)
 {
+    const ClauseView c = set.clauses[given];
+    const FeatureVector features = clauseFeatures(c);
+
     /**
-     * Pravimo kopiju ulazne formule zbog modifikacija koje cemo vrsiti. Uvodimo indekse
-     * za poslednju klauzu na koju smo primenili grupisanje 'idxLastGrpCl' kao i promenljive
-     * za pracenje na koje smo klauze primenili pravilo rezolucije 'idxPrev' i 'idxCurr'.
-     * Ideja je da rezolviramo klauze sa desna na levo. Na primer klauze 1 i 0, zatim 2 i 0,
-     * zatim 2 i 1, zatim 3 i 0, zatim 3 i 1, zatim 3 i 2 itd. Razlog za ovo je sto stalno 
-     * dodajemo nove klauze (rezolvente ili rezultate grupisanja) i na ovaj nacin izbegavamo
-     * pozivanje rezolucije vise puta za iste klauze.
-     */
-    CNF cpyCnf = cnf;
-    unsigned idxLastGrpCl = 0;
-    unsigned idxPrev = 0;
-    unsigned idxCurr = 1;
-    
-    /**
-     * Dok se skup klauza menja, proveravamo da li smo izveli praznu klauzu
+     * Unapred: pri izvodjenju je klauza proverena samo u odnosu na tada zadrzane klauze,
+     * a u medjuvremenu su mogle da se pojave klauze koje je sadrze
      */
-    while (grouping(cpyCnf, idxLastGrpCl) || resolventFound(cpyCnf, idxPrev, idxCurr))
+    std::vector<std::uint32_t> candidates;
+    set.features.subsuming(features, candidates);
+    const LazyClause lc = concrete(c);
+    for (std::uint32_t idx : candidates)
     {
-        if (cpyCnf.cend() != std::find_if(cpyCnf.cbegin(), 
-                                          cpyCnf.cend(), 
-                                          [=](const Clause &c) 
-        { return c.empty(); }))
+        if (idx != given && canSubsume(set, idx, set.support[given]) && subsumes(set.clauses[idx], lc))
         {
+            removeClause(set, given);
             return false;
         }
     }
+
+    /* Unazad: izabrana klauza brise sve aktivne i pasivne klauze koje sadrzi */
+    candidates.clear();
+    set.features.subsumed(features, candidates);
+    for (std::uint32_t idx : candidates)
+    {
+        if (idx != given && canSubsume(set, given, set.support[idx]) && subsumes(c, concrete(set.clauses[idx])))
+        {
+            removeClause(set, idx);
+        }
+    }
+
+    /* U indeks ulaze samo literali na kojima su dozvoljena izvodjenja */
+    set.states[given] = ClauseState::Active;
+    set.eligible.resize(set.states.size());
+    set.eligible[given] = eligibleLiterals(set, c);
+    for (size_t k = 0; k < c.size(); ++k)
+    {
+        if (set.eligible[given][k])
+        {
+            set.literals.insert(c[k].atom(), c[k].negated(), {given, static_cast<std::uint32_t>(k)});
+        }
+    }
     return true;
 }
 
+/**
+ * @brief generate - izvodi sve faktore izabrane klauze i sve zakljucke u kojima ona ucestvuje
+ * zajedno sa aktivnim klauzama
+ */
+static void generate(ClauseSet &set, unsigned given, UnifierCache &cache, BatchUnifier &batch)
+{
+    tryGroupLiterals(set, given, cache);
+    if (set.inference != ResolutionOptions::Inference::Binary)
+    {
+        generateNucleus(set, given);
+    }
+    if (!set.binary)
+    {
+        return;
+    }
+
+    /**
+     * Rezolviramo samo sa aktivnim klauzama koje imaju bar jedan komplementaran literal koji
+     * se moze unifikovati. Literali aktivnih klauza su u indeksu, pa se parovi klauza bez
+     * takvih literala ni ne obilaze. Izabrana klauza je vec aktivna, pa se rezolvira i sa
+     * svojom preimenovanom kopijom.
+     */
+    std::vector<DiscriminationTree::Entry> candidates;
+    const ClauseView c = set.clauses[given];
+    for (size_t k = 0; k < c.size(); ++k)
+    {
+        if (set.eligible[given][k])
+        {
+            set.literals.unifiable(c[k].atom(), !c[k].negated(), candidates);
+        }
+    }
+
+    /* Aktivne klauze obradjujemo u rastucem poretku */
+    std::vector<unsigned> partners;
+    partners.reserve(candidates.size());
+    for (const auto &entry : candidates)
+    {
+        partners.push_back(entry.clause);
+    }
+    std::sort(partners.begin(), partners.end());
+    partners.erase(std::unique(partners.begin(), partners.end()), partners.end());
+    for (unsigned partner : partners)
+    {
+        if (set.stopped)
+        {
+            return;
+        }
+
+        tryResolveClauses(set, partner, given, batch);
+    }
+}
+
+ResolutionOptions ResolutionOptions::preset(Preset p)
+{
+    ResolutionOptions options;
+    switch (p)
+    {
+    case Preset::Default:
+        break;
+    case Preset::SetOfSupport:
+        options.ordering = Ordering::None;
+        options.setOfSupport = true;
+        options.unitPreference = true;
+        break;
+    case Preset::UnitPreference:
+        options.unitPreference = true;
+        break;
+    case Preset::BreadthFirst:
+        options.ordering = Ordering::None;
+        options.pickGivenRatio = 0;
+        break;
+    }
+    return options;
+}
+
+/**
+ * @brief addInput - prepisuje ulazne klauze u skup, preskacuci tautologije i suvisne klauze
+ */
+static void addInput(ClauseSet &set, const CNF &cnf, bool support)
+{
+    for (const Clause &c : cnf)
+    {
+        std::vector<ClauseLiteral> literals;
+        literals.reserve(c.size());
+        for (const Formula &l : c)
+        {
+            literals.push_back(ClauseLiteral::fromFormula(l));
+        }
+
+        /* Uredjeni literali: tautologija se prepoznaje jednim prolazom */
+        ClauseStore::normalize(literals);
+        set.horn = set.horn && std::count_if(literals.cbegin(), literals.cend(),
+                                             [](const ClauseLiteral &l) { return !l.negated(); }) <= 1;
+        const ClauseView view(literals.data(), literals.data() + literals.size());
+        if (!view.tautology() && !seenVariant(set, concrete(view), support) && !clauseExists(set, concrete(view), support))
+        {
+            addClause(set, std::move(literals), support);
+        }
+    }
+}
+
+ResolutionResult resolution(const CNF &cnf)
+{
+    UnifierCache cache;
+    return resolution(CNF(), cnf, ResolutionOptions(), cache);
+}
+
+ResolutionResult resolution(const CNF &cnf, const ResolutionOptions &options)
+{
+    UnifierCache cache;
+    return resolution(CNF(), cnf, options, cache);
+}
+
+ResolutionResult resolution(const CNF &cnf, UnifierCache &cache)
+{
+    return resolution(CNF(), cnf, ResolutionOptions(), cache);
+}
+
+ResolutionResult resolution(const CNF &cnf, const ResolutionOptions &options, UnifierCache &cache)
+{
+    return resolution(CNF(), cnf, options, cache);
+}
+
+ResolutionResult resolution(const CNF &axioms, const CNF &goal, const ResolutionOptions &options)
+{
+    UnifierCache cache;
+    return resolution(axioms, goal, options, cache);
+}
+
+ResolutionResult resolution(const CNF &axioms, const CNF &goal, const ResolutionOptions &options, UnifierCache &cache)
+{
+    /**
+     * Klauze ulazne formule prepisujemo u skladiste klauza i sve postaju pasivne. U svakom
+     * koraku iz pasivnog skupa biramo jednu klauzu (najlaksu, a povremeno najstariju, videti
+     * ResolutionOptions::pickGivenRatio). Izabrana klauza se uprosti u odnosu na ostale
+     * klauze, postaje aktivna, pa se u pasivni skup dodaju njeni faktori i sve njene
+     * rezolvente sa aktivnim klauzama. Aktivne klauze su zato uvek zatvorene u odnosu na
+     * pravila izvodjenja. Formula je nezadovoljiva ako se izvede prazna klauza, a zadovoljiva
+     * ako se pasivni skup isprazni, osim ako je neka izvedena klauza odbacena zbog ogranicenja.
+     * Uz strategiju skupa podrske aksiome se ne rezolviraju medjusobno, vec samo sa klauzama
+     * cilja i njihovim potomcima. Svi cvorovi napravljeni tokom rezolucije se alociraju iz
+     * zasebnog regiona koji se oslobadja odjednom.
+     */
+    Region::Scope regionScope(makeRef<Region>());
+    BatchUnifier batch;
+    ClauseSet set(options);
+
+    /* Cilj se dodaje prvi, da ga aksioma koja je varijanta ne bi izbacila iz skupa podrske */
+    addInput(set, goal, true);
+    /* Skup podrske uz hiperrezoluciju ili UR rezoluciju nije potpun, pa se tada zanemaruje */
+    addInput(set, axioms, !options.setOfSupport || options.inference != ResolutionOptions::Inference::Binary);
+    if (set.inference == ResolutionOptions::Inference::UnitResulting)
+    {
+        set.binary = !set.horn;
+    }
+
+    std::uint32_t given;
+    while (!set.refuted && !set.passive.empty() && !limitReached(set))
+    {
+        set.passive.pop(given);
+        if (activate(set, given))
+        {
+            generate(set, given, cache, batch);
+        }
+    }
+
+    /* Atomi u kesu su iz regiona ovog poziva i u sledecem pozivu ne mogu dati pogodak */
+    cache.evict();
+    if (set.refuted)
+    {
+        return ResolutionResult::Unsatisfiable;
+    }
+    return set.stopped || set.incomplete ? ResolutionResult::Unknown : ResolutionResult::Satisfiable;
+}
+
+bool subsumes(const Clause &c, const Clause &d)
+{
+    std::vector<ClauseLiteral> literals;
+    literals.reserve(c.size());
+    for (const Formula &l : c)
+    {
+        literals.push_back(ClauseLiteral::fromFormula(l));
+    }
+    ClauseStore::normalize(literals);
+
+    LazyClause target;
+    target.reserve(d.size());
+    for (const Formula &l : d)
+    {
+        target.push_back({ClauseLiteral::fromFormula(l), nullptr});
+    }
+    return subsumes(ClauseView(literals.data(), literals.data() + literals.size()), target);
+}
+
 std::ostream &operator<<(std::ostream &out, const CNF &cnf)
 {
     out << "[";
@@ -348,3 +1591,17 @@ std::ostream &operator<<(std::ostream &out, const CNF &cnf)
     }
     return out << "]";
 }
+
+std::ostream &operator<<(std::ostream &out, ResolutionResult result)
+{
+    switch (result)
+    {
+    case ResolutionResult::Unsatisfiable:
+        return out << "unsatisfiable";
+    case ResolutionResult::Satisfiable:
+        return out << "satisfiable";
+    case ResolutionResult::Unknown:
+        return out << "unknown";
+    }
+    return out;
+}
@@ -2,7 +2,11 @@
 #define RESOLUTION_H
 
 #include "base_formula.h"
+#include "unification.h"
 
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <vector>
 #include <iostream>
 
@@ -12,15 +16,227 @@
 using Clause = std::vector<Formula>;
 using CNF = std::vector<Clause>;
 
+/**
+ * @brief ResolutionResult - ishod rezolucije
+ */
+enum class ResolutionResult
+{
+    /* Izvedena je prazna klauza */
+    Unsatisfiable,
+    /* Skup klauza je zasicen bez prazne klauze */
+    Satisfiable,
+    /* Rezolucija je prekinuta ili je odbacena klauza zbog ogranicenja, pa ishod nije poznat */
+    Unknown
+};
+
+/**
+ * @brief CancellationToken - zahtev za prekid rezolucije, moze se postaviti iz druge niti
+ * @details Rezolucija proverava token pre izbora svake klauze i pre svake izvedene klauze, pa se
+ * prekid ne desava trenutno.
+ */
+class CancellationToken
+{
+public:
+    inline void cancel() { m_cancelled.store(true, std::memory_order_relaxed); }
+
+    inline bool cancelled() const { return m_cancelled.load(std::memory_order_relaxed); }
+
+    inline void reset() { m_cancelled.store(false, std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> m_cancelled{false};
+};
+
+/**
+ * @brief ResolutionOptions - podesavanja algoritma rezolucije
+ */
+struct ResolutionOptions
+{
+    /**
+     * @brief Ordering - uredjenje atoma kojim se ogranicavaju izvodjenja
+     */
+    enum class Ordering
+    {
+        /* Bez uredjenja, rezolvira se po svim literalima */
+        None,
+        /* Knuth-Bendix uredjenje */
+        KBO,
+        /* Leksikografsko uredjenje putanja */
+        LPO
+    };
+
+    /**
+     * @brief Selection - funkcija izbora negativnih literala klauze
+     */
+    enum class Selection
+    {
+        /* Nista se ne bira, izvodjenja su na maksimalnim literalima */
+        None,
+        /* Biraju se svi negativni literali */
+        AllNegative,
+        /* Bira se najveci negativan literal (po broju simbola) */
+        LargestNegative
+    };
+
+    /**
+     * @brief Inference - pravilo izvodjenja
+     */
+    enum class Inference
+    {
+        /* Binarna rezolucija sa grupisanjem */
+        Binary,
+        /**
+         * Pozitivna hiperrezolucija: svi negativni literali jezgra (nucleus) se odjednom
+         * rezolviraju sa pozitivnim klauzama (electrons). Funkcija izbora se zanemaruje,
+         * jer je hiperrezolucija uredjena rezolucija u kojoj su izabrani svi negativni literali.
+         */
+        Hyper,
+        /**
+         * Rezolucija sa jedinicnim ishodom (UR): svi literali jezgra osim najvise jednog se
+         * odjednom rezolviraju sa jedinicnim klauzama. Uredjenje i izbor se zanemaruju. Pravilo
+         * je potpuno za Hornove klauze, pa se za ostale formule zadrzava i binarna rezolucija.
+         */
+        UnitResulting
+    };
+
+    /**
+     * @brief Preset - unapred pripremljena kombinacija podesavanja
+     */
+    enum class Preset
+    {
+        /* Uredjena rezolucija (KBO) bez izbora literala */
+        Default,
+        /* Skup podrske uz prednost jedinicnih klauza, bez uredjenja */
+        SetOfSupport,
+        /* Uredjena rezolucija uz prednost jedinicnih klauza */
+        UnitPreference,
+        /* Neogranicena rezolucija, klauze se biraju po starosti */
+        BreadthFirst
+    };
+
+    /**
+     * @brief preset - podesavanja zadate kombinacije
+     */
+    static ResolutionOptions preset(Preset p);
+
+    /**
+     * @brief pickGivenRatio - broj izbora najlakse pasivne klauze na jedan izbor najstarije,
+     * 0 znaci da se klauze biraju samo po starosti (pretraga u sirinu)
+     */
+    unsigned pickGivenRatio = 5;
+
+    Ordering ordering = Ordering::KBO;
+
+    Selection selection = Selection::None;
+
+    Inference inference = Inference::Binary;
+
+    /**
+     * @brief setOfSupport - strategija skupa podrske: svaka rezolventa mora imati bar jednog
+     * roditelja izvedenog iz cilja, pa se aksiome ne rezolviraju medjusobno
+     * @details Strategija je potpuna ako su aksiome zadovoljive i ako se izvodjenja ne
+     * ogranicavaju uredjenjem ni izborom literala. Vazi samo za binarnu rezoluciju.
+     */
+    bool setOfSupport = false;
+
+    /**
+     * @brief unitPreference - jedinicne klauze se biraju iz pasivnog skupa pre svih ostalih
+     */
+    bool unitPreference = false;
+
+    /**
+     * @brief Limits - ogranicenja resursa, vrednost 0 znaci da ogranicenja nema
+     *
+     * @details Kada se dostigne ogranicenje vremena, broja klauza ili memorije, rezolucija staje
+     * sa ishodom Unknown. Izvedene klauze sa dubljim termom ili vecom tezinom od dozvoljene se
+     * odbacuju, pa zasicen skup tada ne dokazuje zadovoljivost i ishod je takodje Unknown.
+     */
+    struct Limits
+    {
+        /* Najduze trajanje rezolucije */
+        std::chrono::milliseconds time{0};
+        /* Najveci broj izvedenih klauza, ukljucujuci i odbacene */
+        std::size_t generated = 0;
+        /* Najveci broj istovremeno zadrzanih klauza (pasivnih i aktivnih), ukljucujuci i ulazne */
+        std::size_t kept = 0;
+        /* Najveca dubina terma u izvedenoj klauzi */
+        unsigned termDepth = 0;
+        /* Najveca tezina (broj simbola) izvedene klauze */
+        unsigned clauseWeight = 0;
+        /* Najveca procena zauzete memorije u bajtovima: region termova i skladiste klauza */
+        std::size_t memory = 0;
+    };
+
+    Limits limits;
+
+    /**
+     * @brief cancellation - token za prekid rezolucije, nullptr ako se ne moze prekinuti
+     */
+    const CancellationToken *cancellation = nullptr;
+};
+
 /**
  * @brief resolution - algoritam rezolucije
- * @details Algoritam rezolucije je implementiran kao binarna rezolucija sa grupisanjem.
+ * @details Algoritam rezolucije je implementiran kao binarna rezolucija sa grupisanjem, u
+ * petlji izabrane klauze (given-clause) u stilu DISCOUNT-a: iz skupa pasivnih klauza se bira
+ * jedna, uprosti se u odnosu na aktivne klauze, pa se sa njima rezolvira i postaje aktivna.
+ * Rezolucija je uredjena: izvodjenja se vrse samo na izabranim negativnim literalima, a ako
+ * u klauzi nema izabranih, na literalima koji nisu manji od nekog drugog literala klauze.
+ * Grupisanje se tada vrsi samo nad pozitivnim literalima. Umesto binarne rezolucije moze se
+ * koristiti hiperrezolucija ili UR rezolucija (videti ResolutionOptions::inference), koje
+ * jezgro rezolviraju sa vise klauza odjednom i zadrzavaju samo krajnji zakljucak.
  * Iako je ovo potpun sistem, postoje formule za koje se algoritam ne zaustavlja jer logika
- * prvog reda nije odluciva.
+ * prvog reda nije odluciva, pa se rad moze ograniciti (videti ResolutionOptions::limits) ili
+ * prekinuti spolja (videti ResolutionOptions::cancellation).
  * @param cnf - ulazna formula u KNF-u
- * @return true ako je formula zadovoljiva, false inace
+ * @return ishod rezolucije
  */
-bool resolution(const CNF &cnf);
+ResolutionResult resolution(const CNF &cnf);
+
+/**
+ * @brief resolution - algoritam rezolucije sa zadatim podesavanjima
+ * @param cnf - ulazna formula u KNF-u
+ * @param options - podesavanja algoritma
+ * @return ishod rezolucije
+ */
+ResolutionResult resolution(const CNF &cnf, const ResolutionOptions &options);
+
+/**
+ * @brief resolution - algoritam rezolucije sa zadatim kesom unifikatora
+ * @details Kes se moze deliti izmedju vise poziva, a njegovi brojaci pogodaka i promasaja
+ * sluze za podesavanje njegove velicine. Ulazi se brisu na kraju poziva, jer pripadaju
+ * regionu tog poziva.
+ * @param cnf - ulazna formula u KNF-u
+ * @param cache - kes unifikatora parova atoma
+ * @return ishod rezolucije
+ */
+ResolutionResult resolution(const CNF &cnf, UnifierCache &cache);
+
+ResolutionResult resolution(const CNF &cnf, const ResolutionOptions &options, UnifierCache &cache);
+
+/**
+ * @brief resolution - algoritam rezolucije nad aksiomama i ciljem
+ * @details Cilj su klauze negiranog tvrdjenja. Bez strategije skupa podrske (videti
+ * ResolutionOptions::setOfSupport) sve klauze se tretiraju isto.
+ * @param axioms - klauze aksioma
+ * @param goal - klauze cilja
+ * @param options - podesavanja algoritma
+ * @return ishod rezolucije
+ */
+ResolutionResult resolution(const CNF &axioms, const CNF &goal, const ResolutionOptions &options);
+
+ResolutionResult resolution(const CNF &axioms, const CNF &goal, const ResolutionOptions &options, UnifierCache &cache);
+
+/**
+ * @brief subsumes - provera da li klauza 'c' sadrzi (theta-subsumira) klauzu 'd'
+ * @details Isti test sadrzanosti koji rezolucija koristi za brisanje suvisnih klauza.
+ * Uparivanje literala je injektivno, pa klauza ne sadrzi svoje faktore. Promenljive
+ * klauze 'd' se ne vezuju, vec se tretiraju kao konstante.
+ * @param c - klauza koja sadrzi, njeni ponovljeni literali se racunaju jednom
+ * @param d - klauza koja je sadrzana
+ * @return true ako postoji supstitucija σ tako da su razliciti literali σ(c) razliciti literali 'd'
+ */
+bool subsumes(const Clause &c, const Clause &d);
 
 /**
  * @brief operator << - ispisuje KNF formulu u citljivom formatu
@@ -30,4 +246,6 @@ bool resolution(const CNF &cnf);
  */
 std::ostream& operator<<(std::ostream &out, const CNF &cnf);
 
+std::ostream& operator<<(std::ostream &out, ResolutionResult result);
+
 #endif // RESOLUTION_H
@@ -11,7 +11,7 @@ class Signature
 public:
     using Sptr = std::shared_ptr<Signature>;
 private:
-    using Map = std::unordered_map<std::string, Arity>;
+    using Map = std::unordered_map<Symbol, Arity>;
 private:
     static unsigned s_UniqueCounter;
 public:
@@ -0,0 +1,149 @@
+#ifndef SMALLVECTOR_H
+#define SMALLVECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+/**
+ * @brief SmallVector - niz koji prvih N elemenata cuva u samom objektu, bez alokacije
+ *
+ * @details Namenjen je za kratke nizove trivijalno kopirljivih elemenata (na primer celije
+ * ravnog terma), pa se elementi kopiraju i pomeraju sa memcpy. Tek kada broj elemenata
+ * predje N, elementi se prebacuju u niz na hipu.
+ */
+template <typename T, std::size_t N>
+class SmallVector
+{
+    static_assert(std::is_trivially_copyable<T>::value, "SmallVector cuva samo trivijalno kopirljive tipove");
+
+public:
+    SmallVector() = default;
+
+    SmallVector(const SmallVector &oth)
+    {
+        assign(oth);
+    }
+
+    SmallVector(SmallVector &&oth)
+    {
+        steal(oth);
+    }
+
+    SmallVector& operator=(const SmallVector &oth)
+    {
+        if (this != &oth)
+        {
+            m_size = 0;
+            assign(oth);
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector &&oth)
+    {
+        if (this != &oth)
+        {
+            m_heap.reset();
+            steal(oth);
+        }
+        return *this;
+    }
+
+    inline std::size_t size() const { return m_size; }
+
+    inline bool empty() const { return m_size == 0; }
+
+    /**
+     * @brief isInline - da li su elementi i dalje u samom objektu
+     */
+    inline bool isInline() const { return !m_heap; }
+
+    inline T* data() { return m_heap ? m_heap.get() : reinterpret_cast<T*>(m_inline); }
+
+    inline const T* data() const { return m_heap ? m_heap.get() : reinterpret_cast<const T*>(m_inline); }
+
+    inline T& operator[](std::size_t i) { return data()[i]; }
+
+    inline const T& operator[](std::size_t i) const { return data()[i]; }
+
+    inline T* begin() { return data(); }
+
+    inline T* end() { return data() + m_size; }
+
+    inline const T* begin() const { return data(); }
+
+    inline const T* end() const { return data() + m_size; }
+
+    inline T& back() { return data()[m_size - 1]; }
+
+    inline const T& back() const { return data()[m_size - 1]; }
+
+    inline void clear() { m_size = 0; }
+
+    inline void pop_back() { --m_size; }
+
+    void push_back(const T &value)
+    {
+        if (m_size == m_capacity)
+        {
+            reserve(2 * m_capacity);
+        }
+        data()[m_size++] = value;
+    }
+
+    /**
+     * @brief resize - menja broj elemenata, novi elementi nisu inicijalizovani
+     */
+    void resize(std::size_t size)
+    {
+        reserve(size);
+        m_size = size;
+    }
+
+    void reserve(std::size_t capacity)
+    {
+        if (capacity <= m_capacity)
+        {
+            return;
+        }
+        std::unique_ptr<T[]> heap(new T[capacity]);
+        std::memcpy(static_cast<void*>(heap.get()), data(), m_size * sizeof(T));
+        m_heap = std::move(heap);
+        m_capacity = capacity;
+    }
+
+private:
+    void assign(const SmallVector &oth)
+    {
+        reserve(oth.m_size);
+        std::memcpy(static_cast<void*>(data()), oth.data(), oth.m_size * sizeof(T));
+        m_size = oth.m_size;
+    }
+
+    void steal(SmallVector &oth)
+    {
+        if (oth.m_heap)
+        {
+            m_heap = std::move(oth.m_heap);
+            m_capacity = oth.m_capacity;
+        }
+        else
+        {
+            m_capacity = N;
+            std::memcpy(m_inline, oth.m_inline, oth.m_size * sizeof(T));
+        }
+        m_size = oth.m_size;
+        oth.m_size = 0;
+        oth.m_capacity = N;
+    }
+
+    alignas(T) unsigned char m_inline[N * sizeof(T)];
+    std::unique_ptr<T[]> m_heap;
+    std::size_t m_size = 0;
+    std::size_t m_capacity = N;
+};
+
+#endif // SMALLVECTOR_H
@@ -0,0 +1,60 @@
+#include "symbol_table.h"
+
+Symbol::Symbol(const std::string &name)
+    : m_id(SymbolTable::intern(name))
+{
+}
+
+Symbol::Symbol(const char *name)
+    : m_id(SymbolTable::intern(name))
+{
+}
+
+const std::string &Symbol::name() const
+{
+    return SymbolTable::name(m_id);
+}
+
+SymbolTable::Data::Data()
+{
+    /* Id 0 je rezervisan za prazan simbol */
+    names.emplace_back();
+    ids.emplace(names.back(), 0);
+}
+
+SymbolTable::Data &SymbolTable::data()
+{
+    /* Tabela se namerno nikad ne unistava jer simboli mogu da nadzive staticke objekte */
+    static Data *s_data = new Data();
+    return *s_data;
+}
+
+Symbol::Id SymbolTable::intern(std::string_view name)
+{
+    Data &d = data();
+    auto it = d.ids.find(name);
+    if (it != d.ids.cend())
+    {
+        return it->second;
+    }
+
+    Symbol::Id id = static_cast<Symbol::Id>(d.names.size());
+    d.names.emplace_back(name);
+    d.ids.emplace(d.names.back(), id);
+    return id;
+}
+
+const std::string &SymbolTable::name(Symbol::Id id)
+{
+    return data().names[id];
+}
+
+std::size_t SymbolTable::size()
+{
+    return data().names.size();
+}
+
+std::ostream &operator<<(std::ostream &out, const Symbol &s)
+{
+    return out << s.name();
+}
@@ -0,0 +1,97 @@
+#ifndef SYMBOLTABLE_H
+#define SYMBOLTABLE_H
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * @brief Symbol - simbol promenljive, funkcije ili relacije predstavljen gustim celobrojnim id-jem
+ *
+ * @details Ime simbola se cuva samo jednom u tabeli simbola, a sva poredjenja i hesiranja
+ * se vrse nad id-jem. Ime se dohvata iz tabele samo prilikom ispisa.
+ */
+class Symbol
+{
+public:
+    using Id = std::uint32_t;
+
+    /**
+     * @brief Symbol - prazan simbol (id 0)
+     */
+    Symbol() : m_id(0) {}
+
+    /**
+     * @brief Symbol - simbol sa zadatim imenom, ime se ubacuje u tabelu ako ne postoji
+     */
+    Symbol(const std::string &name);
+
+    Symbol(const char *name);
+
+    inline Id id() const { return m_id; }
+
+    /**
+     * @brief name - ime simbola iz tabele simbola
+     */
+    const std::string& name() const;
+
+    inline bool operator==(const Symbol &oth) const { return m_id == oth.m_id; }
+
+    inline bool operator!=(const Symbol &oth) const { return m_id != oth.m_id; }
+
+    inline bool operator<(const Symbol &oth) const { return m_id < oth.m_id; }
+
+private:
+    Id m_id;
+};
+
+/**
+ * @brief SymbolTable - globalna tabela koja slika imena simbola u guste id-jeve i nazad
+ */
+class SymbolTable
+{
+public:
+    /**
+     * @brief intern - vraca id imena, dodaje ime u tabelu ako ne postoji
+     */
+    static Symbol::Id intern(std::string_view name);
+
+    /**
+     * @brief name - ime simbola sa zadatim id-jem
+     */
+    static const std::string& name(Symbol::Id id);
+
+    /**
+     * @brief size - broj simbola u tabeli
+     */
+    static std::size_t size();
+
+private:
+    struct Data
+    {
+        Data();
+
+        /* deque ne pomera elemente pa pogledi (string_view) u mapi ostaju validni */
+        std::deque<std::string> names;
+        std::unordered_map<std::string_view, Symbol::Id> ids;
+    };
+
+    static Data& data();
+};
+
+std::ostream& operator<<(std::ostream &out, const Symbol &s);
+
+namespace std
+{
+    template <>
+    struct hash<Symbol>
+    {
+        std::size_t operator()(const Symbol &s) const { return s.id(); }
+    };
+}
+
+#endif // SYMBOLTABLE_H
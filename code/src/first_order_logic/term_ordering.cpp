@@ -0,0 +1,289 @@
+#include "term_ordering.h"
+#include "atom.h"
+#include "function_term.h"
+#include "variable_term.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+struct TermOrdering::Head
+{
+    Symbol symbol;
+    const std::vector<Term> *args;
+    /* Broj simbola, tj. KBO tezina */
+    unsigned weight;
+    /* Cvor terma, nullptr za atom */
+    const BaseTerm *term;
+};
+
+using Head = TermOrdering::Head;
+
+static Head headOf(const BaseTerm *t)
+{
+    const FunctionTerm *f = static_cast<const FunctionTerm*>(t);
+    return Head{f->symbol(), &f->operands(), t->size(), t};
+}
+
+static Head headOf(const Atom *a)
+{
+    return Head{a->symbol(), &a->operands(), static_cast<unsigned>(a->size()), nullptr};
+}
+
+static inline const Variable& variableOf(const BaseTerm *t)
+{
+    return static_cast<const VariableTerm*>(t)->variable();
+}
+
+/**
+ * @brief occurs - da li se promenljiva 'v' javlja u termu 't'
+ */
+static bool occurs(const Variable &v, const BaseTerm *t)
+{
+    if (!(t->variablesMask() & variableBit(v)))
+    {
+        return false;
+    }
+    if (t->kind() == BaseTerm::Kind::Variable)
+    {
+        return variableOf(t) == v;
+    }
+    for (const Term &op : static_cast<const FunctionTerm*>(t)->operands())
+    {
+        if (occurs(v, op.get()))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+Comparison TermOrdering::precedence(const Symbol &f, std::size_t arityF, const Symbol &g, std::size_t arityG)
+{
+    if (arityF != arityG)
+    {
+        return arityF > arityG ? Comparison::Greater : Comparison::Less;
+    }
+    if (f != g)
+    {
+        return g < f ? Comparison::Greater : Comparison::Less;
+    }
+    return Comparison::Equal;
+}
+
+/**
+ * Razlika broja pojavljivanja svake promenljive u dva terma. Promenljivih u klauzama ima
+ * malo, pa je linearna pretraga niza brza od mape.
+ */
+using VariableBalance = std::vector<std::pair<Variable, int>>;
+
+static void addVariables(const BaseTerm *t, int delta, VariableBalance &balance)
+{
+    if (t->isGround())
+    {
+        return;
+    }
+    if (t->kind() == BaseTerm::Kind::Variable)
+    {
+        const Variable &v = variableOf(t);
+        auto it = std::find_if(balance.begin(), balance.end(),
+                               [&](const std::pair<Variable, int> &b) { return b.first == v; });
+        if (it == balance.end())
+        {
+            balance.emplace_back(v, delta);
+        }
+        else
+        {
+            it->second += delta;
+        }
+        return;
+    }
+    for (const Term &op : static_cast<const FunctionTerm*>(t)->operands())
+    {
+        addVariables(op.get(), delta, balance);
+    }
+}
+
+/**
+ * @brief admit - ishod KBO poredjenja posle provere uslova nad brojem pojavljivanja promenljivih
+ */
+static Comparison admit(Comparison c, const VariableBalance &balance)
+{
+    if (c == Comparison::Greater)
+    {
+        for (const auto &b : balance)
+        {
+            if (b.second < 0)
+            {
+                return Comparison::Incomparable;
+            }
+        }
+    }
+    else if (c == Comparison::Less)
+    {
+        for (const auto &b : balance)
+        {
+            if (b.second > 0)
+            {
+                return Comparison::Incomparable;
+            }
+        }
+    }
+    return c;
+}
+
+Comparison KnuthBendixOrdering::compare(const BaseTerm *s, const BaseTerm *t) const
+{
+    /* Cvorovi su iz Factory-ja, pa su jednaki termovi isti cvor */
+    if (s == t)
+    {
+        return Comparison::Equal;
+    }
+    if (s->kind() == BaseTerm::Kind::Variable)
+    {
+        return occurs(variableOf(s), t) ? Comparison::Less : Comparison::Incomparable;
+    }
+    if (t->kind() == BaseTerm::Kind::Variable)
+    {
+        return occurs(variableOf(t), s) ? Comparison::Greater : Comparison::Incomparable;
+    }
+    return compareHeads(headOf(s), headOf(t));
+}
+
+Comparison KnuthBendixOrdering::compare(const Atom *s, const Atom *t) const
+{
+    if (s == t)
+    {
+        return Comparison::Equal;
+    }
+    return compareHeads(headOf(s), headOf(t));
+}
+
+Comparison KnuthBendixOrdering::compareHeads(const Head &s, const Head &t) const
+{
+    VariableBalance balance;
+    for (const Term &op : *s.args)
+    {
+        addVariables(op.get(), 1, balance);
+    }
+    for (const Term &op : *t.args)
+    {
+        addVariables(op.get(), -1, balance);
+    }
+
+    Comparison c;
+    if (s.weight != t.weight)
+    {
+        c = s.weight > t.weight ? Comparison::Greater : Comparison::Less;
+    }
+    else
+    {
+        c = precedence(s.symbol, s.args->size(), t.symbol, t.args->size());
+        if (c == Comparison::Equal)
+        {
+            /* Isti koren: odlucuje prvi par argumenata koji se razlikuju */
+            for (std::size_t i = 0; i < s.args->size() && c == Comparison::Equal; ++i)
+            {
+                c = compare((*s.args)[i].get(), (*t.args)[i].get());
+            }
+        }
+    }
+    return admit(c, balance);
+}
+
+Comparison LexicographicPathOrdering::compare(const BaseTerm *s, const BaseTerm *t) const
+{
+    if (s == t)
+    {
+        return Comparison::Equal;
+    }
+    if (greater(s, t))
+    {
+        return Comparison::Greater;
+    }
+    return greater(t, s) ? Comparison::Less : Comparison::Incomparable;
+}
+
+Comparison LexicographicPathOrdering::compare(const Atom *s, const Atom *t) const
+{
+    if (s == t)
+    {
+        return Comparison::Equal;
+    }
+    Head hs = headOf(s), ht = headOf(t);
+    if (greater(hs, ht))
+    {
+        return Comparison::Greater;
+    }
+    return greater(ht, hs) ? Comparison::Less : Comparison::Incomparable;
+}
+
+bool LexicographicPathOrdering::greater(const BaseTerm *s, const BaseTerm *t) const
+{
+    if (s == t || s->kind() == BaseTerm::Kind::Variable)
+    {
+        return false;
+    }
+    return greater(headOf(s), t);
+}
+
+bool LexicographicPathOrdering::greater(const Head &s, const BaseTerm *t) const
+{
+    if (t->kind() == BaseTerm::Kind::Variable)
+    {
+        /* Term je veci od promenljive koju sadrzi */
+        for (const Term &op : *s.args)
+        {
+            if (occurs(variableOf(t), op.get()))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+    return greater(s, headOf(t));
+}
+
+bool LexicographicPathOrdering::greater(const Head &s, const Head &t) const
+{
+    /* Neki argument s je veci ili jednak t (atom nije argument, pa se ovo preskace za atome) */
+    if (t.term)
+    {
+        for (const Term &op : *s.args)
+        {
+            if (op.get() == t.term || greater(op.get(), t.term))
+            {
+                return true;
+            }
+        }
+    }
+
+    Comparison p = precedence(s.symbol, s.args->size(), t.symbol, t.args->size());
+    if (p == Comparison::Less)
+    {
+        return false;
+    }
+    if (p == Comparison::Equal)
+    {
+        /* Isti koren: prvi par argumenata koji se razlikuju mora biti s_i > t_i */
+        std::size_t i = 0;
+        while (i < s.args->size() && (*s.args)[i] == (*t.args)[i])
+        {
+            ++i;
+        }
+        if (i == s.args->size() || !greater((*s.args)[i].get(), (*t.args)[i].get()))
+        {
+            return false;
+        }
+    }
+
+    /* I u oba preostala slucaja s mora biti vece od svih argumenata t */
+    for (const Term &op : *t.args)
+    {
+        if (!greater(s, op.get()))
+        {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,97 @@
+#ifndef TERMORDERING_H
+#define TERMORDERING_H
+
+#include "base_term.h"
+
+#include <cstdint>
+
+class Atom;
+
+/**
+ * @brief Comparison - ishod poredjenja dva elementa parcijalno uredjenog skupa
+ */
+enum class Comparison : std::uint8_t
+{
+    Less,
+    Equal,
+    Greater,
+    Incomparable
+};
+
+/**
+ * @brief TermOrdering - uredjenje za uprostavanje (simplification ordering) nad termovima i atomima
+ *
+ * @details Uredjenje je stabilno u odnosu na supstitucije: ako je s > t, onda je i σ(s) > σ(t).
+ * Atom se poredi kao term ciji je koren relacijski simbol. Precedenca simbola je fiksna: simbol
+ * vece arnosti je veci, a simboli iste arnosti se porede po redu uvodjenja u tabelu simbola.
+ */
+class TermOrdering
+{
+public:
+    virtual ~TermOrdering() = default;
+
+    virtual Comparison compare(const BaseTerm *s, const BaseTerm *t) const = 0;
+
+    virtual Comparison compare(const Atom *s, const Atom *t) const = 0;
+
+    inline Comparison compare(const Term &s, const Term &t) const { return compare(s.get(), t.get()); }
+
+    /**
+     * @brief Head - koren terma ili atoma sa argumentima, da bi se termovi i atomi poredili istim kodom
+     */
+    struct Head;
+
+protected:
+    /**
+     * @brief precedence - poredjenje simbola 'f' arnosti 'arityF' i simbola 'g' arnosti 'arityG'
+     */
+    static Comparison precedence(const Symbol &f, std::size_t arityF, const Symbol &g, std::size_t arityG);
+};
+
+/**
+ * @brief KnuthBendixOrdering - Knuth-Bendix uredjenje (KBO) sa jedinicnim tezinama
+ *
+ * @details Svaki simbol i svaka promenljiva imaju tezinu 1, pa je tezina terma broj njegovih
+ * simbola, koji cvor terma vec cuva (BaseTerm::size). Term s je veci od terma t ako se svaka
+ * promenljiva u s javlja bar onoliko puta koliko u t, i ako je s tezi od t, ili su iste tezine
+ * a koren s ima vecu precedencu, ili su istog korena a argumenti s su leksikografski veci.
+ */
+class KnuthBendixOrdering final : public TermOrdering
+{
+public:
+    Comparison compare(const BaseTerm *s, const BaseTerm *t) const override;
+
+    Comparison compare(const Atom *s, const Atom *t) const override;
+
+    using TermOrdering::compare;
+
+private:
+    Comparison compareHeads(const Head &s, const Head &t) const;
+};
+
+/**
+ * @brief LexicographicPathOrdering - leksikografsko uredjenje putanja (LPO)
+ *
+ * @details Term s = f(s1, ..., sn) je veci od terma t ako je neki argument si veci ili jednak t,
+ * ili je f vece precedence od korena t i s je veci od svih argumenata t, ili je t = f(t1, ..., tn),
+ * argumenti s su leksikografski veci i s je veci od svih argumenata t. Promenljiva je manja od
+ * svakog terma koji je sadrzi.
+ */
+class LexicographicPathOrdering final : public TermOrdering
+{
+public:
+    Comparison compare(const BaseTerm *s, const BaseTerm *t) const override;
+
+    Comparison compare(const Atom *s, const Atom *t) const override;
+
+    using TermOrdering::compare;
+
+private:
+    bool greater(const BaseTerm *s, const BaseTerm *t) const;
+
+    bool greater(const Head &s, const BaseTerm *t) const;
+
+    bool greater(const Head &s, const Head &t) const;
+};
+
+#endif // TERMORDERING_H
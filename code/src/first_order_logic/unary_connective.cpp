@@ -1,26 +1,90 @@
 #include "unary_connective.h"
+#include "not.h"
+#include "factory.h"
 
-UnaryConnective::UnaryConnective(const Formula &f)
-    : BaseFormula (), m_op(f)
+UnaryConnective::UnaryConnective(Kind kind, const Formula &f)
+    : BaseFormula (kind), m_op(f)
 {
-  
+  m_size = m_op->size() + 1;
+  m_depth = m_op->depth() + 1;
+  m_complexity = m_op->complexity() + 1;
+  m_varMask = m_op->variablesMask();
+  m_ground = m_op->isGround();
+  m_looseBound = m_op->looseBound();
 }
 
-unsigned UnaryConnective::complexity() const
+std::size_t UnaryConnective::shallowHash() const
 {
-  return m_op->complexity() + 1;
+  return m_op->hash();
 }
 
-bool UnaryConnective::equalTo(const Formula &f) const
+bool UnaryConnective::shallowEqualTo(const BaseFormula &f) const
 {
-  if (BaseFormula::equalTo(f))
+  if (BaseFormula::shallowEqualTo(f))
   {
-    return m_op->equalTo(static_cast<const UnaryConnective*>(f.get())->m_op);
+    return m_op->equalTo(static_cast<const UnaryConnective&>(f).m_op);
   }
   return false;
 }
 
+bool UnaryConnective::alphaEquivalentTo(const BaseFormula &f) const
+{
+  if (BaseFormula::shallowEqualTo(f))
+  {
+    return m_op->alphaEquivalent(static_cast<const UnaryConnective&>(f).m_op);
+  }
+  return false;
+}
+
+bool UnaryConnective::containsVariable(const Variable &v, bool free) const
+{
+  return m_op->hasVariable(v, free);
+}
+
 void UnaryConnective::getVars(VariablesSet &vars, bool free) const
 {
   m_op->getVars(vars, free);
 }
+
+Formula UnaryConnective::rebuild(const Formula &op) const
+{
+  if (op == m_op)
+  {
+    return self();
+  }
+  return Factory::make<Not>(op);
+}
+
+Formula UnaryConnective::substitute(const Substitution &s, SubstitutionMemo &memo) const
+{
+  if (!(m_varMask & memo.domain))
+  {
+    return self();
+  }
+  auto memoIt = memo.formulas.find(this);
+  if (memoIt != memo.formulas.cend())
+  {
+    return memoIt->second;
+  }
+  Formula result = rebuild(m_op->substitute(s, memo));
+  memo.formulas.emplace(this, result);
+  return result;
+}
+
+Formula UnaryConnective::abstractVariable(const Variable &v, unsigned index) const
+{
+  if (!(m_varMask & variableBit(v)))
+  {
+    return self();
+  }
+  return rebuild(m_op->abstractVariable(v, index));
+}
+
+Formula UnaryConnective::instantiateBound(unsigned index, const Term &t) const
+{
+  if (m_looseBound <= index)
+  {
+    return self();
+  }
+  return rebuild(m_op->instantiateBound(index, t));
+}
@@ -6,15 +6,33 @@
 class UnaryConnective : public BaseFormula
 {
 public:
-    UnaryConnective(const Formula &f);
+    UnaryConnective(Kind kind, const Formula &f);
+    
+    static inline bool isKind(Kind kind) { return kind == Kind::Not; }
     
     Formula operand() const { return m_op; }
     
-    virtual unsigned complexity() const;
-  
-    virtual bool equalTo(const Formula & f) const;
-  
     virtual void getVars(VariablesSet & vars, bool free = false) const;
+    
+    virtual Formula substitute(const Substitution &s, SubstitutionMemo &memo) const;
+    
+    virtual Formula abstractVariable(const Variable & v, unsigned index) const;
+    
+    virtual Formula instantiateBound(unsigned index, const Term & t) const;
+
+protected:
+    /**
+     * @brief rebuild - formula istog veznika sa novim operandom, ista formula ako se operand nije promenio
+     */
+    Formula rebuild(const Formula &op) const;
+
+    virtual std::size_t shallowHash() const;
+    
+    virtual bool shallowEqualTo(const BaseFormula &f) const;
+    
+    virtual bool alphaEquivalentTo(const BaseFormula &f) const;
+    
+    virtual bool containsVariable(const Variable & v, bool free) const;
 
 protected:
     Formula m_op;
@@ -1,200 +1,685 @@
 #include "unification.h"
 #include "variable_term.h"
 #include "function_term.h"
+#include "atom.h"
+#include "not.h"
+#include "factory.h"
 
 #include <algorithm>
+#include <string>
 
-static void factoring(TermPairs &termPairs)
+/* Boje klasa pri proveri ciklusa */
+static constexpr std::uint8_t White = 0;
+static constexpr std::uint8_t Grey = 1;
+static constexpr std::uint8_t Black = 2;
+
+/**
+ * Tabela promenljivih po bankama: banks[b][k] je promenljiva sa lokalnim indeksom k u banci b,
+ * a locals[id] lokalni indeks uvecan za jedan promenljive banke 0 sa datim id-jem (0 ako nije iz banke 0).
+ * localMask je unija bitova (variableBit) svih promenljivih banke 0.
+ */
+struct VariableBanks
+{
+    std::vector<std::vector<Variable>> banks;
+    std::vector<std::uint32_t> locals;
+    VariablesMask localMask = 0;
+};
+
+static VariableBanks& variableBanks()
+{
+    static VariableBanks s_banks;
+    return s_banks;
+}
+
+Variable bankVariable(unsigned bank, unsigned index)
 {
-    /* Za svaki par termova proveravamo da li postoji par koji mu je jednak */
-    for (size_t i = 0; i < termPairs.size(); ++i)
+    VariableBanks &vb = variableBanks();
+    if (bank >= vb.banks.size())
+    {
+        vb.banks.resize(bank + 1);
+    }
+    std::vector<Variable> &variables = vb.banks[bank];
+    while (variables.size() <= index)
     {
-        for (size_t j = i+1; j < termPairs.size(); )
+        const unsigned k = static_cast<unsigned>(variables.size());
+        variables.push_back(Variable("_" + std::to_string(k) + "_" + std::to_string(bank)));
+        if (bank == 0)
         {
-            /* Ako su parovi jednaki izbacujemo par indeksiran sa j */
-            if (termPairs[i].first->equalTo(termPairs[j].first) && 
-                    termPairs[i].second->equalTo(termPairs[j].second))
-            {
-                /* Zamena sa krajnjim elementom i izbacivanje 
-         * poslednjeg elementa nakon zamene */
-                std::swap(termPairs[j], termPairs.back());
-                termPairs.pop_back();
-            }
-            else /* Ukoliko parovi nisu isti prelazimo na sledeci par */
+            const Symbol::Id id = variables.back().id();
+            if (id >= vb.locals.size())
             {
-                ++j;
+                vb.locals.resize(id + 1, 0);
             }
+            vb.locals[id] = k + 1;
+            vb.localMask |= variableBit(variables.back());
         }
     }
+    return variables[index];
 }
 
-static void tautology(TermPairs &termPairs)
+int localIndex(const Variable &v)
 {
-    /* Prolazimo kroz sve parove i eliminisemo one koji sadrze 2 ista terma */
-    for (size_t i = 0; i < termPairs.size(); )
+    const std::vector<std::uint32_t> &locals = variableBanks().locals;
+    return v.id() < locals.size() ? static_cast<int>(locals[v.id()]) - 1 : -1;
+}
+
+/**
+ * @brief hasLocalVariable - da li term sadrzi promenljivu banke 0
+ * @details Podtermovi ciji potpis promenljivih nema nijedan bit lokalnih promenljivih se preskacu.
+ */
+static bool hasLocalVariable(const BaseTerm *t)
+{
+    if (!(t->variablesMask() & variableBanks().localMask))
     {
-        if (termPairs[i].first->equalTo(termPairs[i].second))
-        {
-            std::swap(termPairs[i], termPairs.back());
-            termPairs.pop_back();
-        }
-        else
+        return false;
+    }
+    if (t->kind() == BaseTerm::Kind::Variable)
+    {
+        return localIndex(static_cast<const VariableTerm*>(t)->variable()) >= 0;
+    }
+    if (t->kind() == BaseTerm::Kind::Function)
+    {
+        for (const Term &op : static_cast<const FunctionTerm*>(t)->operands())
         {
-            ++i;
+            if (hasLocalVariable(op.get()))
+            {
+                return true;
+            }
         }
     }
+    return false;
 }
 
-static bool orientation(TermPairs &termPairs)
+std::uint32_t Unifier::slot(const BaseTerm *t, std::uint32_t bank)
 {
-    /* Za svaki par termova proveravamo da li je drugi promenljiva a prvi ne,
-   * ako to jeste slucaj menjamo im mesta
-   */
-    bool change = false;
-    for (auto &termPair : termPairs)
+    /* Term bez promenljivih je isti u svim bankama */
+    if (t->isGround())
+    {
+        bank = 0;
+    }
+    auto it = m_slots.find(SlotKey{t, bank});
+    if (it != m_slots.cend())
+    {
+        return it->second;
+    }
+
+    /**
+     * Isto vazi i za term bez lokalnih promenljivih: njegov kljuc u banci se vezuje za cvor
+     * banke 0, pa se term obilazi samo pri prvom pojavljivanju u banci
+     */
+    if (bank != 0 && !hasLocalVariable(t))
     {
-        if (dynamic_cast<VariableTerm*>(termPair.second.get()) && 
-                !dynamic_cast<VariableTerm*>(termPair.first.get()))
+        std::uint32_t i = slot(t, 0);
+        m_slots.emplace(SlotKey{t, bank}, i);
+        if (m_trailing)
         {
-            std::swap(termPair.first, termPair.second);
-            change = true;
+            m_slotTrail.push_back(SlotKey{t, bank});
         }
+        m_banks = std::max(m_banks, bank + 1);
+        return i;
+    }
+
+    std::uint32_t i = static_cast<std::uint32_t>(m_nodes.size());
+    m_nodes.push_back(Node{t, bank, t, bank, i, 0});
+    m_slots.emplace(SlotKey{t, bank}, i);
+    if (m_trailing)
+    {
+        m_slotTrail.push_back(SlotKey{t, bank});
+    }
+    m_banks = std::max(m_banks, bank + 1);
+    return i;
+}
+
+std::uint32_t Unifier::find(std::uint32_t i)
+{
+    /* Polovljenje putanje: svaki cvor na putu se preusmerava na svog dedu */
+    while (m_nodes[i].parent != i)
+    {
+        record(i);
+        m_nodes[i].parent = m_nodes[m_nodes[i].parent].parent;
+        i = m_nodes[i].parent;
     }
-    return change;
+    return i;
 }
 
-static bool decomposition(TermPairs &termPairs, bool &collision)
+void Unifier::merge(std::uint32_t i, std::uint32_t j, const BaseTerm *schema, std::uint32_t schemaBank)
 {
-    /* Za sve parove */
-    bool change = false;
-    for (size_t i = 0; i < termPairs.size();)
+    if (m_nodes[i].rank < m_nodes[j].rank)
     {
-        /* Proveravamo da li su oba clana para funkcijski termovi */
-        FunctionTerm *first = dynamic_cast<FunctionTerm*>(termPairs[i].first.get());
-        FunctionTerm *second = dynamic_cast<FunctionTerm*>(termPairs[i].second.get());
-        if (first && second)
+        std::swap(i, j);
+    }
+    record(i);
+    record(j);
+    m_nodes[j].parent = i;
+    if (m_nodes[i].rank == m_nodes[j].rank)
+    {
+        ++m_nodes[i].rank;
+    }
+    m_nodes[i].schema = schema;
+    m_nodes[i].schemaBank = schemaBank;
+}
+
+bool Unifier::unify(const Term &t1, const Term &t2)
+{
+    return unify(t1, 0, t2, 0);
+}
+
+bool Unifier::unify(const Term &t1, unsigned bank1, const Term &t2, unsigned bank2)
+{
+    m_stack.emplace_back(t1.get(), bank1, t2.get(), bank2);
+    while (!m_stack.empty())
+    {
+        const BaseTerm *l, *r;
+        std::uint32_t lb, rb;
+        std::tie(l, lb, r, rb) = m_stack.back();
+        m_stack.pop_back();
+
+        /* Termovi su iz Factory-ja: isti cvor je isti term, a razliciti termovi bez promenljivih se ne unifikuju */
+        if (l == r && (lb == rb || l->isGround()))
+        {
+            continue;
+        }
+        if (l->isGround() && r->isGround())
         {
-            /* Ako im se simboli razlikuju unifikacija nije uspela */
-            if (first->symbol() != second->symbol())
+            return false;
+        }
+
+        std::uint32_t li = find(slot(l, lb));
+        std::uint32_t ri = find(slot(r, rb));
+        if (li == ri)
+        {
+            continue;
+        }
+
+        const BaseTerm *ls = m_nodes[li].schema;
+        const BaseTerm *rs = m_nodes[ri].schema;
+        const std::uint32_t lsb = m_nodes[li].schemaBank;
+        const std::uint32_t rsb = m_nodes[ri].schemaBank;
+        if (ls->kind() == BaseTerm::Kind::Variable)
+        {
+            /* Kao i kod pravila orijentacije: par (x, t) daje x -> t, pa i (x, y) daje x -> y */
+            merge(li, ri, rs, rsb);
+        }
+        else if (rs->kind() == BaseTerm::Kind::Variable)
+        {
+            merge(li, ri, ls, lsb);
+        }
+        else if (ls->kind() != BaseTerm::Kind::Function || rs->kind() != BaseTerm::Kind::Function)
+        {
+            /* Vezana promenljiva je jednaka samo sama sebi */
+            return false;
+        }
+        else
+        {
+            const FunctionTerm *lf = static_cast<const FunctionTerm*>(ls);
+            const FunctionTerm *rf = static_cast<const FunctionTerm*>(rs);
+            if (lf->symbol() != rf->symbol() || lf->operands().size() != rf->operands().size())
             {
-                collision = true;
                 return false;
             }
-            else
+
+            /* Klase se spajaju pre razlaganja, pa se isti par shema nikad ne razlaze ponovo */
+            merge(li, ri, rs, rsb);
+            for (std::size_t k = lf->operands().size(); k-- > 0; )
             {
-                /* Simboli su im isti, dodajemo u listu parova parove operanada */
-                for (size_t j =0; j < first->operands().size(); ++j)
-                {
-                    termPairs.emplace_back(first->operands()[j], second->operands()[j]);
-                }
-                
-                /* Brisemo tekuci par nakon dekompozicije */
-                std::swap(termPairs[i], termPairs.back());
-                termPairs.pop_back();
-                change = true;
+                m_stack.emplace_back(lf->operands()[k].get(), lsb, rf->operands()[k].get(), rsb);
             }
         }
-        else
-        {
-            ++i;
-        }
     }
-    
-    return change;
+    return true;
 }
 
-static bool application(TermPairs &termPairs, bool &cycle)
+bool Unifier::acyclic(const BaseTerm *t, std::uint32_t bank)
 {
-    /* Primenjujemo supstituciju v->t za sve parove oblika <v, t>, 
-     * originalni par se eliminise a supstitucija se primenjuje na
-     * sve ostale parove
-     */
-    bool change = false;
-    for (size_t i = 0; i < termPairs.size(); ++i)
-    {
-        /* Proveravamo da li je prvi clan para promenljiva */
-        VariableTerm *first = dynamic_cast<VariableTerm*>(termPairs[i].first.get());
-        Term second = termPairs[i].second;
-        if (first)
-        {
-            /* Ako drugi clan para tj. term sadrzi promenljivu koja je prvi clan
-             * unifikacija nije uspela
-             */
-            if (second->hasVariable(first->variable()))
+    if (t->isGround())
+    {
+        return true;
+    }
+
+    std::uint32_t i = find(slot(t, bank));
+    m_color.resize(m_nodes.size(), White);
+    if (m_color[i] == Black)
+    {
+        return true;
+    }
+    if (m_color[i] == Grey)
+    {
+        return false;
+    }
+
+    m_color[i] = Grey;
+    const BaseTerm *schema = m_nodes[i].schema;
+    if (schema->kind() == BaseTerm::Kind::Function)
+    {
+        const std::uint32_t schemaBank = m_nodes[i].schemaBank;
+        for (const Term &op : static_cast<const FunctionTerm*>(schema)->operands())
+        {
+            if (!acyclic(op.get(), schemaBank))
             {
-                cycle = true;
                 return false;
             }
-            else
-            {
-                /* Za sve parove termova osim tekuceg para primeni supstituciju */
-                for (size_t j = 0; j < termPairs.size(); ++j)
-                {
-                    auto &tpJ = termPairs[j];
-                    if (i != j)
-                    {
-                        /* Supstituciju primenjujemo na oba clana para termova */
-                        if (tpJ.first->hasVariable(first->variable()))
-                        {
-                            tpJ.first = tpJ.first->substitute(first->variable(), second);
-                            change = true;
-                        }
-                        if (tpJ.second->hasVariable(first->variable()))
-                        {
-                            tpJ.second = tpJ.second->substitute(first->variable(), second);
-                            change = true;
-                        }
-                    }
-                }
-            }
         }
     }
-    
-    return change;
+    m_color[i] = Black;
+    return true;
 }
 
-static bool unify(TermPairs &termPairs)
+bool Unifier::acyclic()
 {
-    bool repeat = false;
-    bool cycle = false;
-    bool collision = false;
-    do {
-        
-        factoring(termPairs);
-        tautology(termPairs);
-        repeat = orientation(termPairs) || 
-                decomposition(termPairs, collision) || 
-                application(termPairs, cycle);
-        
-        if (collision || cycle)
+    /* Obilazak registruje i podtermove shema koji nisu bili deo nijednog para,
+     * pa posle njega svaki term sa promenljivama ima svoj indeks
+     */
+    m_color.assign(m_nodes.size(), White);
+    for (std::uint32_t i = 0; i < m_nodes.size(); ++i)
+    {
+        if (!acyclic(m_nodes[i].term, m_nodes[i].bank))
         {
             return false;
         }
-    } while (repeat);
-    
+    }
+    m_resolved.assign(m_nodes.size(), Term());
+    return true;
+}
+
+Term Unifier::resolve(const BaseTerm *t, std::uint32_t bank)
+{
+    if (t->isGround())
+    {
+        return Term(const_cast<BaseTerm*>(t));
+    }
+
+    std::uint32_t i = find(m_slots.find(SlotKey{t, bank})->second);
+    if (m_resolved[i])
+    {
+        return m_resolved[i];
+    }
+
+    const BaseTerm *schema = m_nodes[i].schema;
+    const std::uint32_t schemaBank = m_nodes[i].schemaBank;
+    Term result(const_cast<BaseTerm*>(schema));
+    if (schema->kind() == BaseTerm::Kind::Function)
+    {
+        const FunctionTerm *f = static_cast<const FunctionTerm*>(schema);
+        std::vector<Term> operands;
+        operands.reserve(f->operands().size());
+        bool changed = false;
+        for (const Term &op : f->operands())
+        {
+            operands.push_back(resolve(op.get(), schemaBank));
+            changed = changed || !operands.back()->equalTo(op);
+        }
+        if (changed)
+        {
+            result = Factory::make<FunctionTerm>(f->symbol(), operands);
+        }
+    }
+    else if (schema->kind() == BaseTerm::Kind::Variable && schemaBank != 0)
+    {
+        /* Nevezana promenljiva iz banke se cita kao promenljiva te banke */
+        const int index = localIndex(static_cast<const VariableTerm*>(schema)->variable());
+        if (index >= 0)
+        {
+            result = Factory::make<VariableTerm>(bankVariable(schemaBank, static_cast<unsigned>(index)));
+        }
+    }
+    m_resolved[i] = result;
+    return result;
+}
+
+bool Unifier::solve(Substitution &s)
+{
+    if (!acyclic())
+    {
+        return false;
+    }
+
+    s.clear();
+    for (std::uint32_t i = 0; i < m_nodes.size(); ++i)
+    {
+        const BaseTerm *t = m_nodes[i].term;
+        if (t->kind() != BaseTerm::Kind::Variable || m_nodes[i].bank != 0)
+        {
+            continue;
+        }
+        Term value = resolve(t, 0);
+        if (value.get() != t)
+        {
+            s[static_cast<const VariableTerm*>(t)->variable()] = value;
+        }
+    }
+    return true;
+}
+
+bool Unifier::solve(std::vector<Substitution> &envs)
+{
+    if (!acyclic())
+    {
+        return false;
+    }
+
+    envs.resize(m_banks);
+    for (Substitution &env : envs)
+    {
+        env.clear();
+    }
+    for (std::uint32_t i = 0; i < m_nodes.size(); ++i)
+    {
+        const BaseTerm *t = m_nodes[i].term;
+        if (t->kind() != BaseTerm::Kind::Variable)
+        {
+            continue;
+        }
+        const Variable &v = static_cast<const VariableTerm*>(t)->variable();
+        const std::uint32_t bank = m_nodes[i].bank;
+        Term value = resolve(t, bank);
+        if (value.get() == t)
+        {
+            continue;
+        }
+        if (bank == 0 && localIndex(v) < 0)
+        {
+            /* Promenljiva koja nije lokalna je ista u svim bankama, pa ima istu vrednost u svakom okruzenju */
+            for (Substitution &env : envs)
+            {
+                env[v] = value;
+            }
+        }
+        else
+        {
+            envs[bank][v] = value;
+        }
+    }
     return true;
-} 
+}
+
+Unifier::Mark Unifier::mark()
+{
+    m_trailing = true;
+    return Mark{m_nodes.size(), m_trail.size(), m_slotTrail.size(), m_banks};
+}
+
+void Unifier::undo(const Mark &m)
+{
+    /* Neuspela jednakost ostavlja neobradjene parove na steku */
+    m_stack.clear();
+    while (m_trail.size() > m.changes)
+    {
+        m_nodes[m_trail.back().first] = m_trail.back().second;
+        m_trail.pop_back();
+    }
+    while (m_slotTrail.size() > m.slots)
+    {
+        m_slots.erase(m_slotTrail.back());
+        m_slotTrail.pop_back();
+    }
+    m_nodes.erase(m_nodes.begin() + static_cast<std::ptrdiff_t>(m.nodes), m_nodes.end());
+    m_banks = m.banks;
+}
+
+void Unifier::clear()
+{
+    m_nodes.clear();
+    m_slots.clear();
+    m_stack.clear();
+    m_color.clear();
+    m_resolved.clear();
+    m_trail.clear();
+    m_slotTrail.clear();
+    m_trailing = false;
+    m_banks = 1;
+}
 
 OptionalSubstitution unify(const TermPairs &termPairs)
 {
-    /* Kopiramo skup termova da bismo mogli da ga menjamo i unifikujemo  */
-    TermPairs cpyPairs = termPairs;
-    if (!unify(cpyPairs))
+    Substitution s;
+    if (!unify(termPairs, s))
+    {
+        return {};
+    }
+    return s;
+}
+
+OptionalSubstitution unify(const Atom *a1, const Atom *a2)
+{
+    if (a1->symbol() != a2->symbol() || a1->operands().size() != a2->operands().size())
     {
         return {};
     }
     
-    /* Iz skupa parova izvlacimo supstituciju */
-    Substitution s;
-    for (const auto &termsPair : cpyPairs)
+    Unifier unifier;
+    const std::vector<Term> &ops1 = a1->operands();
+    const std::vector<Term> &ops2 = a2->operands();
+    for (size_t i = 0; i < ops1.size(); ++i)
     {
-        const VariableTerm *vterm = static_cast<const VariableTerm*>(termsPair.first.get());
-        s[vterm->variable()] = termsPair.second;
+        if (!unifier.unify(ops1[i], ops2[i]))
+        {
+            return {};
+        }
     }
     
+    Substitution s;
+    if (!unifier.solve(s))
+    {
+        return {};
+    }
     return s;
 }
 
+UnifierCache::UnifierCache(std::size_t capacity)
+{
+    std::size_t size = 1;
+    while (size < capacity)
+    {
+        size <<= 1;
+    }
+    m_entries.resize(size);
+}
+
+const OptionalSubstitution& UnifierCache::unify(const Atom *a1, const Atom *a2)
+{
+    Entry &entry = m_entries[hashCombine(a1->hash(), a2->hash()) & (m_entries.size() - 1)];
+    if (entry.first.get() == a1 && entry.second.get() == a2)
+    {
+        ++m_hits;
+        return entry.mgu;
+    }
+    
+    ++m_misses;
+    entry.first = Formula(const_cast<Atom*>(a1));
+    entry.second = Formula(const_cast<Atom*>(a2));
+    entry.mgu = ::unify(a1, a2);
+    return entry.mgu;
+}
+
+void UnifierCache::evict()
+{
+    for (Entry &entry : m_entries)
+    {
+        entry = Entry();
+    }
+}
+
+void UnifierCache::clear()
+{
+    evict();
+    m_hits = 0;
+    m_misses = 0;
+}
+
+void AtomBatch::push_back(const Atom *a)
+{
+    m_symbols.push_back(a->symbol().id());
+    m_arities.push_back(static_cast<std::uint32_t>(a->operands().size()));
+    m_atoms.push_back(a);
+}
+
+void AtomBatch::clear()
+{
+    m_symbols.clear();
+    m_arities.clear();
+    m_atoms.clear();
+}
+
+const std::vector<BatchUnifier::Result>& BatchUnifier::unify(const Atom *query, const AtomBatch &candidates)
+{
+    return unify(query, candidates, 0);
+}
+
+const std::vector<BatchUnifier::Result>& BatchUnifier::unify(const Atom *query, const AtomBatch &candidates, unsigned candidateBank)
+{
+    m_results.clear();
+    const std::size_t n = candidates.size();
+    m_pass.resize(n);
+    
+    /* Filter bez grananja nad kolonama, da bi se petlja mogla vektorizovati */
+    const Symbol::Id symbol = query->symbol().id();
+    const std::uint32_t arity = static_cast<std::uint32_t>(query->operands().size());
+    const Symbol::Id *symbols = candidates.m_symbols.data();
+    const std::uint32_t *arities = candidates.m_arities.data();
+    std::uint8_t *pass = m_pass.data();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        pass[i] = static_cast<std::uint8_t>((symbols[i] == symbol) & (arities[i] == arity));
+    }
+    
+    const std::vector<Term> &ops1 = query->operands();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        if (!pass[i])
+        {
+            continue;
+        }
+        
+        m_unifier.clear();
+        const std::vector<Term> &ops2 = candidates[i]->operands();
+        bool unifiable = true;
+        for (std::size_t k = 0; unifiable && k < ops1.size(); ++k)
+        {
+            unifiable = m_unifier.unify(ops1[k], 0, ops2[k], candidateBank);
+        }
+        if (!unifiable)
+        {
+            continue;
+        }
+        
+        if (candidateBank == 0)
+        {
+            Substitution s;
+            if (m_unifier.solve(s))
+            {
+                m_results.push_back(Result{i, std::move(s), Substitution()});
+            }
+        }
+        else if (m_unifier.solve(m_envs))
+        {
+            m_envs.resize(candidateBank + 1);
+            m_results.push_back(Result{i, std::move(m_envs[0]), std::move(m_envs[candidateBank])});
+        }
+    }
+    return m_results;
+}
+
+/**
+ * @brief matchTerm - uparivanje podterma, nove promenljive iz domena se pamte u 'trail'
+ */
+static bool matchTerm(const BaseTerm *pattern, const BaseTerm *target, Substitution &s, std::vector<Variable> &trail)
+{
+    /* Obrazac bez promenljivih se uparuje samo sa istim cvorom */
+    if (pattern->isGround())
+    {
+        return pattern == target;
+    }
+
+    if (pattern->kind() == BaseTerm::Kind::Variable)
+    {
+        const Variable &v = static_cast<const VariableTerm*>(pattern)->variable();
+        auto it = s.find(v);
+        if (it != s.cend())
+        {
+            return it->second.get() == target;
+        }
+        s.emplace_hint(it, v, Term(const_cast<BaseTerm*>(target)));
+        trail.push_back(v);
+        return true;
+    }
+
+    if (pattern->kind() != BaseTerm::Kind::Function || target->kind() != BaseTerm::Kind::Function)
+    {
+        return pattern == target;
+    }
+
+    const FunctionTerm *pf = static_cast<const FunctionTerm*>(pattern);
+    const FunctionTerm *tf = static_cast<const FunctionTerm*>(target);
+    if (pf->symbol() != tf->symbol() || pf->operands().size() != tf->operands().size())
+    {
+        return false;
+    }
+    for (std::size_t i = 0; i < pf->operands().size(); ++i)
+    {
+        if (!matchTerm(pf->operands()[i].get(), tf->operands()[i].get(), s, trail))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief undo - ponistava vezivanja dodata neuspelim uparivanjem
+ */
+static void undo(Substitution &s, const std::vector<Variable> &trail)
+{
+    for (const Variable &v : trail)
+    {
+        s.erase(v);
+    }
+}
+
+bool match(const Term &pattern, const Term &target, Substitution &s)
+{
+    std::vector<Variable> trail;
+    if (!matchTerm(pattern.get(), target.get(), s, trail))
+    {
+        undo(s, trail);
+        return false;
+    }
+    return true;
+}
+
+bool match(const Formula &pattern, const Formula &target, Substitution &s)
+{
+    const BaseFormula *p = pattern.get();
+    const BaseFormula *t = target.get();
+    if (p->kind() == BaseFormula::Kind::Not && t->kind() == BaseFormula::Kind::Not)
+    {
+        p = static_cast<const Not*>(p)->operand().get();
+        t = static_cast<const Not*>(t)->operand().get();
+    }
+
+    if (p->isGround() || p->kind() != BaseFormula::Kind::Atom || t->kind() != BaseFormula::Kind::Atom)
+    {
+        return p == t;
+    }
+
+    const Atom *pa = static_cast<const Atom*>(p);
+    const Atom *ta = static_cast<const Atom*>(t);
+    if (pa->symbol() != ta->symbol() || pa->operands().size() != ta->operands().size())
+    {
+        return false;
+    }
+
+    std::vector<Variable> trail;
+    for (std::size_t i = 0; i < pa->operands().size(); ++i)
+    {
+        if (!matchTerm(pa->operands()[i].get(), ta->operands()[i].get(), s, trail))
+        {
+            undo(s, trail);
+            return false;
+        }
+    }
+    return true;
+}
+
 std::ostream &operator<<(std::ostream &out, const Substitution &s)
 {
     out << "[\t";
@@ -217,19 +702,13 @@ std::ostream &operator<<(std::ostream &out, const TermPairs &pairs)
 
 bool unify(const TermPairs &termPairs, Substitution &s)
 {
-    TermPairs cpyPairs = termPairs;
-    if (!unify(cpyPairs))
-    {
-        return false;
-    }
-    
-    /* Iz skupa parova izvlacimo supstituciju */
-    s.clear();
-    for (const auto &termsPair : cpyPairs)
+    Unifier unifier;
+    for (const auto &termPair : termPairs)
     {
-        const VariableTerm *vterm = static_cast<const VariableTerm*>(termsPair.first.get());
-        s[vterm->variable()] = termsPair.second;
+        if (!unifier.unify(termPair.first, termPair.second))
+        {
+            return false;
+        }
     }
-    
-    return true;
+    return unifier.solve(s);
 }
@@ -5,9 +5,14 @@
 #include "base_term.h"
 #include "base_formula.h"
 
+#include <cstdint>
 #include <vector>
 #include <experimental/optional>
 #include <iostream>
+#include <tuple>
+#include <unordered_map>
+
+class Atom;
 
 /**
  * Niz parova termova koje cemo koristiti u supstituciji
@@ -20,6 +25,165 @@ using TermPairs = std::vector<std::pair<Term, Term>>;
  */
 using OptionalSubstitution = std::experimental::optional<Substitution>;
 
+/**
+ * @brief bankVariable - promenljiva sa lokalnim indeksom 'index' u banci 'bank'
+ *
+ * @details Klauze rezolucije koriste samo promenljive banke 0, numerisane lokalno u svakoj
+ * klauzi. Premise jednog izvodjenja se razdvajaju tako sto se svaka cita u svojoj banci,
+ * bez prepisivanja termova premisa. Ime promenljive se pravi samo prvi put, posle se cita
+ * iz tabele.
+ */
+Variable bankVariable(unsigned bank, unsigned index);
+
+/**
+ * @brief localIndex - lokalni indeks promenljive banke 0, ili -1 ako promenljiva nije iz banke 0
+ */
+int localIndex(const Variable &v);
+
+/**
+ * @brief Unifier - unifikacija nad klasama ekvivalencije termova (union-find, u stilu Huet-a)
+ *
+ * @details Svaki obidjeni cvor terma dobija gust indeks, a cvorovi koji se izjednacavaju
+ * spajaju se u klase. Klasa pamti svoj reprezentativni term (shemu): funkcijski term ako ga
+ * klasa sadrzi, inace promenljivu. Par termova se razlaze samo kada se spajaju dve klase,
+ * pa se svaki cvor obradi najvise jednom i nema ponovnog prepisivanja ostalih parova kao kod
+ * pravila primene. Provera pojavljivanja je odlozena: na kraju se jednim obilaskom klasa
+ * proverava da graf shema nema ciklus, a supstitucija se gradi tek tada, sa memoizacijom po
+ * klasi, pa deljeni podtermovi ostaju deljeni.
+ *
+ * Termovi koji se unifikuju moraju da zive dok se koristi objekat, on cuva samo pokazivace.
+ *
+ * Termovi se mogu citati u razlicitim bankama promenljivih (videti bankVariable): isti cvor
+ * u dve banke su dva terma sa razlicitim promenljivama, pa se premise ne moraju preimenovati.
+ * U bankama vecim od 0 lokalne promenljive banke 0 se citaju kao odgovarajuce promenljive
+ * banke, a ostale promenljive su iste u svim bankama.
+ *
+ * Jednakosti dodate posle mark() se mogu ponistiti sa undo(), pa pretraga sa vracanjem
+ * dodaje samo novi par na vec izgradjene klase umesto da ponovo unifikuje sve parove.
+ * Od prvog poziva mark() svaka izmena cvora se zapisuje u trag.
+ */
+class Unifier
+{
+public:
+    /**
+     * @brief unify - dodaje jednakost t1 = t2
+     * @return false ako je doslo do sukoba simbola, true inace (ciklus se otkriva tek u solve())
+     */
+    bool unify(const Term &t1, const Term &t2);
+
+    /**
+     * @brief unify - dodaje jednakost izmedju terma 't1' iz banke 'bank1' i terma 't2' iz banke 'bank2'
+     */
+    bool unify(const Term &t1, unsigned bank1, const Term &t2, unsigned bank2);
+
+    /**
+     * @brief solve - proverava pojavljivanje i pravi najopstiji unifikator svih dodatih jednakosti
+     * @param s - supstitucija koja se popunjava, idempotentna je; sadrzi samo promenljive banke 0
+     * @return false ako postoji ciklus (promenljiva se javlja u svojoj vrednosti), true inace
+     */
+    bool solve(Substitution &s);
+
+    /**
+     * @brief solve - isto sto i solve(s), ali sa po jednim okruzenjem za svaku banku
+     * @param envs - envs[b] slika promenljivu, procitanu u banci 'b', u njenu vrednost; u
+     * bankama vecim od 0 sadrzi i nevezane lokalne promenljive, koje se slikaju u promenljive
+     * banke, a vrednosti promenljivih koje nisu lokalne su iste u svim okruzenjima
+     */
+    bool solve(std::vector<Substitution> &envs);
+
+    /**
+     * @brief Mark - stanje unifikatora na koje se vraca sa undo()
+     */
+    struct Mark
+    {
+        std::size_t nodes;
+        std::size_t changes;
+        std::size_t slots;
+        std::uint32_t banks;
+    };
+
+    /**
+     * @brief mark - pamti trenutno stanje, od prvog poziva se izmene cvorova zapisuju u trag
+     */
+    Mark mark();
+
+    /**
+     * @brief undo - ponistava sve jednakosti dodate posle 'm', kao i neuspelu jednakost
+     * @details Ponistava i izmene koje je u medjuvremenu napravio solve().
+     */
+    void undo(const Mark &m);
+
+    /**
+     * @brief clear - brise sve dodate jednakosti, alocirana memorija se zadrzava za sledeci problem
+     */
+    void clear();
+
+private:
+    struct Node
+    {
+        const BaseTerm *term;
+        std::uint32_t bank;
+        /* Shema klase i njena banka, vaze samo za koren */
+        const BaseTerm *schema;
+        std::uint32_t schemaBank;
+        std::uint32_t parent;
+        std::uint32_t rank;
+    };
+
+    struct SlotKey
+    {
+        const BaseTerm *term;
+        std::uint32_t bank;
+
+        inline bool operator==(const SlotKey &oth) const { return term == oth.term && bank == oth.bank; }
+    };
+
+    struct SlotKeyHash
+    {
+        inline std::size_t operator()(const SlotKey &k) const
+        {
+            return hashCombine(std::hash<const BaseTerm*>()(k.term), k.bank);
+        }
+    };
+
+    std::uint32_t slot(const BaseTerm *t, std::uint32_t bank);
+
+    /**
+     * @brief record - zapisuje cvor u trag pre izmene, ako je trag ukljucen
+     */
+    inline void record(std::uint32_t i)
+    {
+        if (m_trailing)
+        {
+            m_trail.emplace_back(i, m_nodes[i]);
+        }
+    }
+
+    std::uint32_t find(std::uint32_t i);
+
+    void merge(std::uint32_t i, std::uint32_t j, const BaseTerm *schema, std::uint32_t schemaBank);
+
+    bool acyclic(const BaseTerm *t, std::uint32_t bank);
+
+    bool acyclic();
+
+    Term resolve(const BaseTerm *t, std::uint32_t bank);
+
+    std::vector<Node> m_nodes;
+    std::unordered_map<SlotKey, std::uint32_t, SlotKeyHash> m_slots;
+    /* Parovi cvorova sa bankama: (levi, banka levog, desni, banka desnog) */
+    std::vector<std::tuple<const BaseTerm*, std::uint32_t, const BaseTerm*, std::uint32_t>> m_stack;
+    /* Broj banaka, tj. najveca koriscena banka uvecana za jedan */
+    std::uint32_t m_banks = 1;
+    /* Stanje obilaska u solve(): boja i razresena vrednost klase */
+    std::vector<std::uint8_t> m_color;
+    std::vector<Term> m_resolved;
+    /* Trag za undo(): prethodne vrednosti izmenjenih cvorova i kljucevi dodatih ulaza tabele */
+    std::vector<std::pair<std::uint32_t, Node>> m_trail;
+    std::vector<SlotKey> m_slotTrail;
+    bool m_trailing = false;
+};
+
 /**
  * @brief unify - unifikuje skup parova termova ako je to moguce
  * @param termPairs - parovi termova koje treba unifikovati
@@ -35,6 +199,157 @@ OptionalSubstitution unify(const TermPairs &termPairs);
  */
 bool unify(const TermPairs &termPairs, Substitution &s);
 
+/**
+ * @brief unify - unifikuje argumente dva atoma ako imaju isti relacijski simbol
+ * @return najopstiji unifikator, ili nista ako atomi nisu unifikabilni
+ */
+OptionalSubstitution unify(const Atom *a1, const Atom *a2);
+
+/**
+ * @brief UnifierCache - ograniceni kes najopstijih unifikatora parova atoma
+ *
+ * @details Tabela je direktno mapirana: par atoma se smesta u ulaz odredjen strukturnim
+ * hesovima oba atoma, a novi par istiskuje stari sa istim ulazom. Ulaz pamti i neuspeh
+ * unifikacije. Atomi su iz Factory-ja, pa se pogodak potvrdjuje poredjenjem pokazivaca;
+ * ulaz drzi reference na svoje atome, pa adresa iz kesa ne moze pripasti drugom atomu.
+ * Redosled atoma je bitan, jer od njega zavisi orijentacija unifikatora.
+ *
+ * Ulazi drze atome i termove regiona u kome su napravljeni, pa se kes koji se deli izmedju
+ * poziva rezolucije prazni na kraju svakog poziva (videti evict), da ne bi cuvao region
+ * zavrsenog poziva.
+ */
+class UnifierCache
+{
+public:
+    /**
+     * @brief UnifierCache konstruktor
+     * @param capacity - broj ulaza, zaokruzuje se na prvi veci stepen dvojke
+     */
+    explicit UnifierCache(std::size_t capacity = 4096);
+
+    /**
+     * @brief unify - isto sto i unify(a1, a2), ali se rezultat cita iz kesa ako postoji
+     * @return referenca na rezultat u kesu, vazi do sledeceg poziva
+     */
+    const OptionalSubstitution& unify(const Atom *a1, const Atom *a2);
+
+    inline std::size_t capacity() const { return m_entries.size(); }
+
+    inline std::size_t hits() const { return m_hits; }
+
+    inline std::size_t misses() const { return m_misses; }
+
+    /**
+     * @brief evict - brise sve ulaze, a brojaci pogodaka i promasaja se zadrzavaju
+     */
+    void evict();
+
+    /**
+     * @brief clear - brise sve ulaze i brojace
+     */
+    void clear();
+
+private:
+    struct Entry
+    {
+        Formula first;
+        Formula second;
+        OptionalSubstitution mgu;
+    };
+
+    std::vector<Entry> m_entries;
+    std::size_t m_hits = 0;
+    std::size_t m_misses = 0;
+};
+
+/**
+ * @brief AtomBatch - niz atoma kandidata za unifikaciju, zapisan po kolonama (SoA)
+ *
+ * @details Relacijski simboli i arnosti su u zasebnim neprekidnim nizovima celih brojeva,
+ * pa se filtriranje kandidata po simbolu i arnosti svodi na poredjenje nizova koje
+ * prevodilac moze da vektorizuje (SIMD), bez citanja samih atoma.
+ */
+class AtomBatch
+{
+    friend class BatchUnifier;
+
+public:
+    void push_back(const Atom *a);
+
+    inline std::size_t size() const { return m_atoms.size(); }
+
+    inline bool empty() const { return m_atoms.empty(); }
+
+    inline const Atom* operator[](std::size_t i) const { return m_atoms[i]; }
+
+    void clear();
+
+private:
+    std::vector<Symbol::Id> m_symbols;
+    std::vector<std::uint32_t> m_arities;
+    std::vector<const Atom*> m_atoms;
+};
+
+/**
+ * @brief BatchUnifier - unifikacija jednog atoma sa svim atomima niza u jednom prolazu
+ *
+ * @details Kandidati se prvo filtriraju po simbolu i arnosti, a preostali se unifikuju jednim
+ * istim objektom Unifier, ciji se pomocni nizovi i tabele ne alociraju ponovo izmedju kandidata
+ * i poziva.
+ */
+class BatchUnifier
+{
+public:
+    struct Result
+    {
+        /* Pozicija kandidata u nizu */
+        std::size_t index;
+        Substitution mgu;
+        /* Okruzenje za literale kandidata citane u banci kandidata, prazno za banku 0 */
+        Substitution candidateMgu;
+    };
+
+    /**
+     * @brief unify - unifikuje 'query' sa svakim atomom iz 'candidates'
+     * @return najopstiji unifikatori za unifikabilne kandidate, u redosledu kandidata;
+     * referenca vazi do sledeceg poziva
+     */
+    const std::vector<Result>& unify(const Atom *query, const AtomBatch &candidates);
+
+    /**
+     * @brief unify - isto sto i unify(query, candidates), ali se kandidati citaju u banci
+     * 'candidateBank', pa ne moraju imati promenljive razlicite od promenljivih upita
+     */
+    const std::vector<Result>& unify(const Atom *query, const AtomBatch &candidates, unsigned candidateBank);
+
+private:
+    Unifier m_unifier;
+    std::vector<Substitution> m_envs;
+    std::vector<std::uint8_t> m_pass;
+    std::vector<Result> m_results;
+};
+
+/**
+ * @brief match - jednosmerno uparivanje: dopunjuje 's' tako da je s(pattern) jednako termu target
+ * @details Promenljive terma 'target' se ne vezuju, vec se tretiraju kao konstante. Vec postojeca
+ * vezivanja u 's' se postuju, pa se uparivanje moze nastaviti preko vise parova. Obilazak staje
+ * na prvom neslaganju.
+ * @param pattern - obrazac
+ * @param target - term koji se uparuje sa obrascem
+ * @param s - supstitucija koja se dopunjuje, ako uparivanje ne uspe ostaje nepromenjena
+ * @return true ako uparivanje postoji, false inace
+ */
+bool match(const Term &pattern, const Term &target, Substitution &s);
+
+/**
+ * @brief match - jednosmerno uparivanje literala (atoma ili negacija atoma)
+ * @details Literali se uparuju samo ako su istog znaka i imaju isti relacijski simbol,
+ * a onda se redom uparuju argumenti. Ostale formule se uparuju samo same sa sobom.
+ * @param s - supstitucija koja se dopunjuje, ako uparivanje ne uspe ostaje nepromenjena
+ * @return true ako uparivanje postoji, false inace
+ */
+bool match(const Formula &pattern, const Formula &target, Substitution &s);
+
 /**
  * @brief operator << - ispisuje supstituciju u citljivom formatu
  * @param out - stream u koji se vrsi ispis
@@ -1,9 +1,11 @@
 #include "variable_term.h"
+#include "bound_variable_term.h"
+#include "factory.h"
 
 VariableTerm::VariableTerm(const Variable &var)
-    : m_var{var}
+    : BaseTerm (Kind::Variable), m_var{var}
 {
-    
+    m_varMask = variableBit(m_var);
 }
 
 std::ostream &VariableTerm::print(std::ostream &out) const
@@ -11,12 +13,16 @@ std::ostream &VariableTerm::print(std::ostream &out) const
     return out << m_var;
 }
 
-bool VariableTerm::equalTo(const Term &oth) const
+std::size_t VariableTerm::shallowHash() const
 {
-    const VariableTerm *pOth = dynamic_cast<const VariableTerm*>(oth.get());
-    if (pOth)
+    return std::hash<Variable>()(m_var);
+}
+
+bool VariableTerm::shallowEqualTo(const BaseTerm &oth) const
+{
+    if (oth.kind() == Kind::Variable)
     {
-        return pOth->variable() == variable();
+        return static_cast<const VariableTerm&>(oth).variable() == variable();
     }
     else
     {
@@ -34,26 +40,29 @@ bool VariableTerm::hasVariable(const Variable &v) const
     return v == variable();
 }
 
-Term VariableTerm::substitute(const Variable &v, const Term &t) const
+Term VariableTerm::substitute(const Substitution &s, SubstitutionMemo &memo) const
 {
-    if (v == m_var)
+    UNUSED_ARG(memo);
+    auto it = s.find(m_var);
+    if (it != s.cend())
     {
-        return t;
-    }
-    else
-    {
-        return std::const_pointer_cast<BaseTerm>(shared_from_this());
+        return it->second;
     }
+    return self();
 }
 
-Term VariableTerm::substitute(const Substitution &s) const
+Term VariableTerm::abstractVariable(const Variable &v, unsigned index) const
 {
-    for (const auto & varTermPair : s)
+    if (v == m_var)
     {
-        if (m_var == varTermPair.first)
-        {
-            return varTermPair.second;
-        }
+        return Factory::make<BoundVariableTerm>(index);
     }
-    return std::const_pointer_cast<BaseTerm>(shared_from_this());
+    return self();
+}
+
+Term VariableTerm::instantiateBound(unsigned index, const Term &t) const
+{
+    UNUSED_ARG(index);
+    UNUSED_ARG(t);
+    return self();
 }
@@ -10,19 +10,27 @@ class VariableTerm : public BaseTerm
 public:
     VariableTerm(const Variable &var = {});
     
+    static inline bool isKind(Kind kind) { return kind == Kind::Variable; }
+    
     inline const Variable& variable() const { return m_var; }
     
     virtual std::ostream& print(std::ostream &out) const;
     
-    virtual bool equalTo(const Term &oth) const;
-    
     virtual void getVariables(VariablesSet &vset) const;
     
     virtual bool hasVariable(const Variable &v) const;
     
-    virtual Term substitute(const Variable &v, const Term &t) const;
+    virtual Term substitute(const Substitution &s, SubstitutionMemo &memo) const;
+    
+    virtual Term abstractVariable(const Variable &v, unsigned index) const;
+    
+    virtual Term instantiateBound(unsigned index, const Term &t) const;
+
+protected:
+    virtual std::size_t shallowHash() const;
+    
+    virtual bool shallowEqualTo(const BaseTerm &oth) const;
 
-    virtual Term substitute(const Substitution &s) const;
 private:
     /**
      * @brief m_var je promenljiva koja odgovara termu, njena vrednost se cita iz valuacije
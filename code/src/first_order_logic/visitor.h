@@ -0,0 +1,63 @@
+#ifndef VISITOR_H
+#define VISITOR_H
+
+class VariableTerm;
+class FunctionTerm;
+class BoundVariableTerm;
+
+class True;
+class False;
+class Atom;
+class Not;
+class And;
+class Or;
+class Imp;
+class Iff;
+class Forall;
+class Exists;
+
+/**
+ * @brief TermVisitor - posetilac termova, BaseTerm::accept bira metodu na osnovu oznake tipa
+ */
+class TermVisitor
+{
+public:
+    virtual void visit(const VariableTerm &t) = 0;
+    
+    virtual void visit(const FunctionTerm &t) = 0;
+    
+    virtual void visit(const BoundVariableTerm &t) = 0;
+    
+    virtual ~TermVisitor() = default;
+};
+
+/**
+ * @brief FormulaVisitor - posetilac formula, BaseFormula::accept bira metodu na osnovu oznake tipa
+ */
+class FormulaVisitor
+{
+public:
+    virtual void visit(const True &f) = 0;
+    
+    virtual void visit(const False &f) = 0;
+    
+    virtual void visit(const Atom &f) = 0;
+    
+    virtual void visit(const Not &f) = 0;
+    
+    virtual void visit(const And &f) = 0;
+    
+    virtual void visit(const Or &f) = 0;
+    
+    virtual void visit(const Imp &f) = 0;
+    
+    virtual void visit(const Iff &f) = 0;
+    
+    virtual void visit(const Forall &f) = 0;
+    
+    virtual void visit(const Exists &f) = 0;
+    
+    virtual ~FormulaVisitor() = default;
+};
+
+#endif // VISITOR_H
@@ -27,7 +27,7 @@ namespace ND
 			EliminatePremiseNode(premiseNode);
 		}
 
-		return std::make_shared<Not>(premise->GetFormula());
+		return Factory::make<Not>(premise->GetFormula());
 	}
 
 	std::optional<Formula> NotElimination::ApplyInternal()
@@ -35,10 +35,10 @@ namespace ND
 		SolverTreeNode LHSNode = GetInputNode<0>();
 		SolverTreeNode RHSNode = GetInputNode<1>();
 
-		Formula negativeLHSFormula = std::make_shared<Not>(LHSNode->GetFormula());
+		Formula negativeLHSFormula = Factory::make<Not>(LHSNode->GetFormula());
 		if (negativeLHSFormula->equalTo(RHSNode->GetFormula()))
 		{
-			return std::make_shared<False>();
+			return Factory::make<False>();
 		}
 		else
 		{
@@ -52,7 +52,7 @@ namespace ND
 		SolverTreeNode LHSNode = GetInputNode<0>();
 		SolverTreeNode RHSNode = GetInputNode<1>();
 
-		return std::make_shared<And>(LHSNode->GetFormula(), RHSNode->GetFormula());
+		return Factory::make<And>(LHSNode->GetFormula(), RHSNode->GetFormula());
 	}
 
 	std::optional<Formula> ConjunctionEliminationLHS::ApplyInternal()
@@ -84,7 +84,7 @@ namespace ND
 		SolverTreeNode node = GetInputNode<0>();
 		Formula formula = GetFormula<0>();
 
-		return std::make_shared<Or>(node->GetFormula(), formula);
+		return Factory::make<Or>(node->GetFormula(), formula);
 	}
 
 	std::optional<Formula> DisjunctionIntroductionRHS::ApplyInternal()
@@ -92,7 +92,7 @@ namespace ND
 		SolverTreeNode node = GetInputNode<0>();
 		Formula formula = GetFormula<0>();
 
-		return std::make_shared<Or>(formula, node->GetFormula());
+		return Factory::make<Or>(formula, node->GetFormula());
 	}
 
 	std::optional<Formula> DisjunctionElimination::ApplyInternal()
@@ -175,7 +175,7 @@ namespace ND
 			EliminatePremiseNode(premiseNode);
 		}
 
-		return std::make_shared<Imp>(premise->GetFormula(), node->GetFormula());
+		return Factory::make<Imp>(premise->GetFormula(), node->GetFormula());
 	}
 
 	std::optional<Formula> ImplicationElimination::ApplyInternal()
@@ -237,12 +237,12 @@ namespace ND
 			EliminatePremiseNode(premiseInstance);
 		}
 
-		return std::make_shared<Not>(premise->GetFormula());
+		return Factory::make<Not>(premise->GetFormula());
 	}
 
 	std::optional<Formula> TrueIntroduction::ApplyInternal()
 	{
-		return std::make_shared<True>();
+		return Factory::make<True>();
 	}
 
 	std::optional<Formula> ForallIntroduction::ApplyInternal()
@@ -256,7 +256,7 @@ namespace ND
 
 		if (nodeFreeVarset.find(varX) == nodeFreeVarset.end())
 		{
-			SetError("Variable " + varX + " doesn't exist as a free variable in formula " + node->GetFormula()->getText() + ". Automatic renaming is currently not supported.");
+			SetError("Variable " + varX.name() + " doesn't exist as a free variable in formula " + node->GetFormula()->getText() + ". Automatic renaming is currently not supported.");
 			return std::nullopt;
 		}
 
@@ -275,14 +275,14 @@ namespace ND
 				premiseNode->GetFormula()->getVars(formulaVars, true);
 				if (formulaVars.find(varX) != formulaVars.end())
 				{
-					SetError("Premise [" + std::to_string(premiseNode->GetPremise()->GetID()) + "] Instance [" + std::to_string(premiseNode->GetID()) + "] has " + varX + " as a free variable. This is not allowed.");
+					SetError("Premise [" + std::to_string(premiseNode->GetPremise()->GetID()) + "] Instance [" + std::to_string(premiseNode->GetID()) + "] has " + varX.name() + " as a free variable. This is not allowed.");
 					return std::nullopt;
 				}
 			}
 		}
 
-		Formula substituteFormula = node->GetFormula()->substitute(varX, std::make_shared<VariableTerm>(varY));
-		return std::make_shared<Forall>(varY, substituteFormula);
+		Formula substituteFormula = node->GetFormula()->substitute(varX, Factory::make<VariableTerm>(varY));
+		return Factory::make<Forall>(varY, substituteFormula);
 	}
 
 	std::optional<Formula> ForallElimination::ApplyInternal()
@@ -296,20 +296,9 @@ namespace ND
 			return std::nullopt;
 		}
 
+		// Bound variables are nameless, so instantiating with any variable cannot capture it
 		Forall* forallFormula = node->GetFormula()->As<Forall>();
-		Formula baseFormula = forallFormula->operand();
-		
-		VariablesSet baseFormulaVarset;
-		VariablesSet baseFormulaFreeVarset;
-		baseFormula->getVars(baseFormulaVarset);
-		baseFormula->getVars(baseFormulaFreeVarset, true);
-		if (baseFormulaVarset.find(var) != baseFormulaVarset.end() && baseFormulaFreeVarset.find(var) == baseFormulaFreeVarset.end())
-		{
-			SetError("Variable " + var + " is a bound variable in " + node->GetFormula()->getText());
-			return std::nullopt;
-		}
-
-		return baseFormula->substitute(forallFormula->variable(), std::make_shared<VariableTerm>(var));
+		return forallFormula->instantiate(Factory::make<VariableTerm>(var));
 	}
 
 	std::optional<Formula> ExistsIntroduction::ApplyInternal()
@@ -323,12 +312,12 @@ namespace ND
 
 		if (nodeFreeVarset.find(varX) == nodeFreeVarset.end())
 		{
-			SetError("Variable " + varX + " doesn't exist as a free variable in formula " + node->GetFormula()->getText() + ". Automatic renaming is currently not supported.");
+			SetError("Variable " + varX.name() + " doesn't exist as a free variable in formula " + node->GetFormula()->getText() + ". Automatic renaming is currently not supported.");
 			return std::nullopt;
 		}
 
-		Formula substituteFormula = node->GetFormula()->substitute(varX, std::make_shared<VariableTerm>(varY));
-		return std::make_shared<Exists>(varY, substituteFormula);
+		Formula substituteFormula = node->GetFormula()->substitute(varX, Factory::make<VariableTerm>(varY));
+		return Factory::make<Exists>(varY, substituteFormula);
 	}
 
 	std::optional<Formula> ExistsElimination::ApplyInternal()
@@ -345,8 +334,7 @@ namespace ND
 		}
 
 		Exists* existsFormula = existsNode->GetFormula()->As<Exists>();
-		Formula baseFormula = existsFormula->operand();
-		if (!baseFormula->substitute(existsFormula->variable(), std::make_shared<VariableTerm>(var))->equalTo(premise->GetFormula()))
+		if (!existsFormula->instantiate(Factory::make<VariableTerm>(var))->equalTo(premise->GetFormula()))
 		{
 			SetError("After removing the exists quantifier from " + existsNode->GetFormula()->getText() + " , we don't get " + premise->GetFormula()->getText());
 			return std::nullopt;
@@ -356,7 +344,7 @@ namespace ND
 		conclusionNode->GetFormula()->getVars(conclusionNodeFreeVarset, true);
 		if (conclusionNodeFreeVarset.find(var) != conclusionNodeFreeVarset.end())
 		{
-			SetError("Found " + var + " as a free variable in " + conclusionNode->GetFormula()->getText());
+			SetError("Found " + var.name() + " as a free variable in " + conclusionNode->GetFormula()->getText());
 			return std::nullopt;
 		}
 
@@ -367,7 +355,7 @@ namespace ND
 		{
 			if (treeNode.second->IsA<SolverTreePremiseNodeBase>())
 			{
-				SolverTreePremiseNode premiseNode = std::dynamic_pointer_cast<SolverTreePremiseNodeBase>(treeNode.second);
+				SolverTreePremiseNode premiseNode = dynamicCast<SolverTreePremiseNodeBase>(treeNode.second);
 
 				if (premiseNode->GetEliminated())
 				{
@@ -394,7 +382,7 @@ namespace ND
 				premiseNode->GetFormula()->getVars(formulaVars);
 				if (formulaVars.find(var) != formulaVars.end())
 				{
-					SetError("Premise [" + std::to_string(premiseNode->GetPremise()->GetID()) + "] Instance [" + std::to_string(premiseNode->GetID()) + "] has " + var + " as a free variable. This is not allowed.");
+					SetError("Premise [" + std::to_string(premiseNode->GetPremise()->GetID()) + "] Instance [" + std::to_string(premiseNode->GetID()) + "] has " + var.name() + " as a free variable. This is not allowed.");
 					return std::nullopt;
 				}
 			}
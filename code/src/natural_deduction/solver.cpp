@@ -4,12 +4,13 @@
 namespace ND
 {
 	Solver::Solver()
+		: m_region(makeRef<Region>())
 	{
 	}
 
 	std::tuple<ID, ID> Solver::AddPremise(Formula formula)
 	{
-		Premise premise = std::make_shared<PremiseBase>(GetNextPremiseID(), formula);
+		Premise premise = makeRef<PremiseBase>(GetNextPremiseID(), formula);
 		m_premises.insert({ premise->GetID(), premise });
 		return std::tuple<ID, ID>(premise->GetID(), m_tree.AddPremiseNode(premise));
 	}
@@ -58,6 +59,7 @@ namespace ND
 
 	bool Solver::ApplyRule(BaseRule& rule, std::string& error)
 	{
+		Region::Scope regionScope(m_region);
 		auto ruleFormula = rule.Apply();
 		if (ruleFormula.has_value())
 		{
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "natural_deduction/solvertree.h"
+#include "first_order_logic/region.h"
 #include "rules.h"
 
 namespace ND
@@ -27,9 +28,13 @@ namespace ND
 
 		bool ApplyRule(BaseRule& rule, std::string& error);
 
+		//All terms and formulas created during the session are allocated from this region
+		const Ref<Region>& GetRegion() const { return m_region; }
+
 	private:
 		ID GetNextPremiseID() { return ++m_premiseIDCounter; }
 
+		Ref<Region> m_region;
 		SolverTree m_tree;
 		std::map<ID, Premise> m_premises;
 
@@ -15,6 +15,7 @@ namespace ND
 
 	bool SolverParser::Parse(const std::string& input)
 	{
+		Region::Scope regionScope(m_solver.GetRegion());
 		m_error = "";
 		std::string inputProcessed = input;
 		inputProcessed.erase(std::remove_if(inputProcessed.begin(), inputProcessed.end(), [](auto & c) { return std::isspace(c); }), inputProcessed.end());
@@ -5,7 +5,7 @@ namespace ND
 {
 	ID SolverTree::AddPremiseNode(Premise premise)
 	{
-		SolverTreePremiseNode node = std::make_shared<SolverTreePremiseNodeBase>();
+		SolverTreePremiseNode node = makeRef<SolverTreePremiseNodeBase>();
 		node->m_formula = premise->GetFormula();
 		node->m_id = GetNextNodeID();
 		node->SetPremise(premise);	//wtf here --> friend class can't access private member??????
@@ -18,7 +18,7 @@ namespace ND
 
 	ID SolverTree::AddFormulaNode(const std::vector<SolverTreeNode>& parentNodes, Formula formula)
 	{
-		SolverTreeNode node = std::make_shared<SolverTreeNodeBase>();
+		SolverTreeNode node = makeRef<SolverTreeNodeBase>();
 		node->m_formula = formula;
 		node->m_id = GetNextNodeID();
 		node->m_resolved = false;
@@ -46,7 +46,7 @@ namespace ND
 	{
 		if (node->m_inputNodes.size() == 0)
 		{
-			SolverTreePremiseNode premise = std::dynamic_pointer_cast<SolverTreePremiseNodeBase>(node);
+			SolverTreePremiseNode premise = dynamicCast<SolverTreePremiseNodeBase>(node);
 			if (!premise->GetEliminated() && premise->GetPremise()->GetID() == premise_id)
 			{
 				premises.push_back(premise);
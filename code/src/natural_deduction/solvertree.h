@@ -10,14 +10,14 @@ namespace ND
 	class SolverTreeNodeBase;
 	class SolverTreeInnerNodeBase;
 	class SolverTreePremiseNodeBase;
-	using SolverTreeNode = std::shared_ptr<SolverTreeNodeBase>;
-	using SolverTreePremiseNode = std::shared_ptr<SolverTreePremiseNodeBase>;
+	using SolverTreeNode = Ref<SolverTreeNodeBase>;
+	using SolverTreePremiseNode = Ref<SolverTreePremiseNodeBase>;
 	using PremiseInstance = SolverTreePremiseNode;
 
 	class PremiseBase;
-	using Premise = std::shared_ptr<PremiseBase>;
+	using Premise = Ref<PremiseBase>;
 
-	class SolverTreeNodeBase : public std::enable_shared_from_this<SolverTreeNodeBase>
+	class SolverTreeNodeBase : public RefCounted
 	{
 		friend class SolverTree;
 
@@ -86,7 +86,7 @@ namespace ND
 
 	};
 
-	class PremiseBase : public std::enable_shared_from_this<PremiseBase>
+	class PremiseBase : public RefCounted
 	{
 	public:
 		PremiseBase(ID id, Formula formula)
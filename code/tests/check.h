@@ -0,0 +1,51 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include "first_order_logic/first_order_logic.h"
+#include "first_order_logic/factory.h"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * Minimalna podrska za testove: CHECK belezi neuspeh i nastavlja, a main vraca broj neuspeha
+ */
+static int s_failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) \
+        { \
+            std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed" << std::endl; \
+            ++s_failures; \
+        } \
+    } while (false)
+
+static inline Term var(const std::string &name)
+{
+    return Factory::make<VariableTerm>(name);
+}
+
+static inline Term fun(const std::string &name, const std::vector<Term> &operands = {})
+{
+    return Factory::make<FunctionTerm>(name, operands);
+}
+
+static inline Formula atom(const std::string &name, const std::vector<Term> &operands = {})
+{
+    return Factory::make<Atom>(name, operands);
+}
+
+static inline Formula neg(const Formula &f)
+{
+    return Factory::make<Not>(f);
+}
+
+static inline int report(const char *name)
+{
+    std::cout << name << ": " << (s_failures ? "FAILED" : "OK") << std::endl;
+    return s_failures == 0 ? 0 : 1;
+}
+
+#endif // CHECK_H
@@ -0,0 +1,137 @@
+#include "check.h"
+#include "first_order_logic/resolution.h"
+
+using Inference = ResolutionOptions::Inference;
+using Ordering = ResolutionOptions::Ordering;
+
+static ResolutionOptions options(Inference inference, Ordering ordering = Ordering::KBO)
+{
+    ResolutionOptions o;
+    o.inference = inference;
+    o.ordering = ordering;
+    return o;
+}
+
+/**
+ * Isti skupovi klauza se proveravaju za svako pravilo izvodjenja: nezadovoljiv skup mora dati
+ * praznu klauzu, a konacan zadovoljiv skup mora se zasititi
+ */
+static void testInference(Inference inference)
+{
+    Term x = var("x"), y = var("y");
+    Term a = fun("a"), b = fun("b");
+
+    /* p(a), p(x) => q(x), q(y) => r(y) */
+    CNF horn = {
+        {atom("p", {a})},
+        {neg(atom("p", {x})), atom("q", {x})},
+        {neg(atom("q", {y})), atom("r", {y})}
+    };
+
+    CNF hornUnsat = horn;
+    hornUnsat.push_back({neg(atom("r", {a}))});
+    CHECK(resolution(hornUnsat, options(inference)) == ResolutionResult::Unsatisfiable);
+    CHECK(resolution(hornUnsat, options(inference, Ordering::LPO)) == ResolutionResult::Unsatisfiable);
+
+    CNF hornSat = horn;
+    hornSat.push_back({neg(atom("r", {b}))});
+    CHECK(resolution(hornSat, options(inference)) == ResolutionResult::Satisfiable);
+
+    /* Sve cetiri klauze nad p i q: nezadovoljivo, ali bez jedinicnih klauza i nije Hornovo */
+    Formula p = atom("p"), q = atom("q");
+    CNF propositional = {{p, q}, {neg(p), q}, {p, neg(q)}, {neg(p), neg(q)}};
+    CHECK(resolution(propositional, options(inference)) == ResolutionResult::Unsatisfiable);
+    CNF dropped(propositional.begin(), propositional.end() - 1);
+    CHECK(resolution(dropped, options(inference)) == ResolutionResult::Satisfiable);
+
+    /* Grupisanje: p(x) \/ p(y) i ~p(u) \/ ~p(v) su nezadovoljive tek kada se literali spoje */
+    Term u = var("u"), v = var("v");
+    CNF factoring = {{atom("p", {x}), atom("p", {y})}, {neg(atom("p", {u})), neg(atom("p", {v}))}};
+    CHECK(resolution(factoring, options(inference)) == ResolutionResult::Unsatisfiable);
+
+    /* Prazna klauza u ulazu */
+    CHECK(resolution({{atom("p", {a})}, {}}, options(inference)) == ResolutionResult::Unsatisfiable);
+}
+
+/**
+ * Zadovoljiv skup za koji se rezolucija bez uredjenja ne zaustavlja: ishod je Unknown kada se
+ * dostigne neko ogranicenje ili kada se rad prekine
+ */
+static void testLimits()
+{
+    Term x = var("x"), y = var("y");
+    Term b = fun("b");
+
+    CNF loop = {
+        {atom("p1", {y}), neg(atom("p1", {x})), neg(atom("p2", {y, x}))},
+        {atom("p2", {y, b})},
+        {atom("p2", {x, b}), neg(atom("p0"))}
+    };
+
+    /* Uredjena rezolucija zasicuje isti skup */
+    CHECK(resolution(loop) == ResolutionResult::Satisfiable);
+
+    ResolutionOptions o = options(Inference::Binary, Ordering::None);
+    {
+        ResolutionOptions limited = o;
+        limited.limits.generated = 200;
+        CHECK(resolution(loop, limited) == ResolutionResult::Unknown);
+    }
+    {
+        ResolutionOptions limited = o;
+        limited.limits.time = std::chrono::milliseconds(100);
+        CHECK(resolution(loop, limited) == ResolutionResult::Unknown);
+    }
+    {
+        CancellationToken token;
+        token.cancel();
+        ResolutionOptions cancelled = o;
+        cancelled.cancellation = &token;
+        CHECK(resolution(loop, cancelled) == ResolutionResult::Unknown);
+    }
+
+    /* p(a), p(x) => p(f(x)): odbacene duboke klauze znace da zasicenje ne dokazuje zadovoljivost */
+    Term a = fun("a");
+    CNF chain = {{atom("p", {a})}, {neg(atom("p", {x})), atom("p", {fun("f", {x})})}};
+    {
+        ResolutionOptions limited = o;
+        limited.limits.termDepth = 4;
+        CHECK(resolution(chain, limited) == ResolutionResult::Unknown);
+    }
+    {
+        /* Svaka izvedena klauza p(f(...f(a)...)) se zadrzava */
+        ResolutionOptions limited = o;
+        limited.limits.kept = 20;
+        CHECK(resolution(chain, limited) == ResolutionResult::Unknown);
+    }
+
+    /* Dokaz koji ostaje u okviru ogranicenja se i dalje nalazi */
+    CNF chainUnsat = chain;
+    chainUnsat.push_back({neg(atom("p", {fun("f", {fun("f", {a})})}))});
+    {
+        ResolutionOptions limited = o;
+        limited.limits.termDepth = 4;
+        CHECK(resolution(chainUnsat, limited) == ResolutionResult::Unsatisfiable);
+    }
+}
+
+static void testSetOfSupport()
+{
+    Term x = var("x");
+    Term a = fun("a");
+
+    CNF axioms = {{atom("p", {a})}, {neg(atom("p", {x})), atom("q", {x})}};
+    ResolutionOptions o = ResolutionOptions::preset(ResolutionOptions::Preset::SetOfSupport);
+    CHECK(resolution(axioms, {{neg(atom("q", {a}))}}, o) == ResolutionResult::Unsatisfiable);
+    CHECK(resolution(axioms, {{neg(atom("q", {fun("b")}))}}, o) == ResolutionResult::Satisfiable);
+}
+
+int main()
+{
+    testInference(Inference::Binary);
+    testInference(Inference::Hyper);
+    testInference(Inference::UnitResulting);
+    testLimits();
+    testSetOfSupport();
+    return report("resolution");
+}
@@ -0,0 +1,40 @@
+#include "check.h"
+#include "first_order_logic/resolution.h"
+
+int main()
+{
+    Term x = var("x"), y = var("y"), z = var("z");
+    Term a = fun("a"), b = fun("b");
+
+    /* Instanca: p(x) sadrzi p(a) \/ q(b) */
+    CHECK(subsumes({atom("p", {x})}, {atom("p", {a}), atom("q", {b})}));
+    CHECK(!subsumes({atom("p", {a}), atom("q", {b})}, {atom("p", {x})}));
+
+    /* Znak literala se mora poklopiti */
+    CHECK(!subsumes({atom("p", {x})}, {neg(atom("p", {a}))}));
+    CHECK(subsumes({neg(atom("p", {x}))}, {neg(atom("p", {a})), atom("p", {b})}));
+
+    /* Ista promenljiva se svuda slika u isti term */
+    CHECK(subsumes({atom("p", {x, x})}, {atom("p", {a, a})}));
+    CHECK(!subsumes({atom("p", {x, x})}, {atom("p", {a, b})}));
+    CHECK(!subsumes({atom("p", {x}), atom("q", {x})}, {atom("p", {a}), atom("q", {b})}));
+
+    /* Uparivanje je injektivno: klauza ne sadrzi svoj faktor */
+    CHECK(!subsumes({atom("p", {x}), atom("p", {y})}, {atom("p", {a})}));
+    CHECK(subsumes({atom("p", {x}), atom("p", {y})}, {atom("p", {a}), atom("p", {b})}));
+    CHECK(!subsumes({atom("p", {x}), atom("p", {y}), atom("p", {z})}, {atom("p", {a}), atom("p", {b})}));
+
+    /* Ponovljen literal se racuna jednom, u obe klauze */
+    CHECK(subsumes({atom("p", {a}), atom("p", {a})}, {atom("p", {a})}));
+    CHECK(!subsumes({atom("p", {x}), atom("p", {y})}, {atom("p", {a}), atom("p", {a})}));
+
+    /* Pretraga se vraca unazad: prvo uparivanje p(x, y) nije dobro */
+    CHECK(subsumes({atom("p", {x, y}), atom("q", {y})}, {atom("p", {a, a}), atom("p", {a, b}), atom("q", {b})}));
+
+    /* Promenljive sadrzane klauze se ne vezuju */
+    CHECK(subsumes({atom("p", {x})}, {atom("p", {y})}));
+    CHECK(!subsumes({atom("p", {a})}, {atom("p", {y})}));
+    CHECK(subsumes({atom("p", {fun("f", {x})})}, {atom("p", {fun("f", {x})})}));
+
+    return report("subsumption");
+}
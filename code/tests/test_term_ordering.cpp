@@ -0,0 +1,90 @@
+#include "check.h"
+#include "first_order_logic/term_ordering.h"
+
+/**
+ * @brief checkBoth - proverava poredjenje u oba smera, s ? t i t ? s
+ */
+static void checkBoth(const TermOrdering &ordering, const Term &s, const Term &t, Comparison expected)
+{
+    static const Comparison converse[] = {Comparison::Greater, Comparison::Equal, Comparison::Less, Comparison::Incomparable};
+
+    CHECK(ordering.compare(s, t) == expected);
+    CHECK(ordering.compare(t, s) == converse[static_cast<int>(expected)]);
+}
+
+/**
+ * Zajednicka svojstva oba uredjenja: term je veci od svog podterma, razlicite promenljive
+ * su neuporedive, a promenljiva koja se javlja samo u jednom termu sprecava poredjenje
+ */
+static void testCommon(const TermOrdering &ordering)
+{
+    Term x = var("x"), y = var("y");
+    Term a = fun("a");
+
+    checkBoth(ordering, fun("f", {x}), fun("f", {x}), Comparison::Equal);
+    checkBoth(ordering, fun("f", {x}), x, Comparison::Greater);
+    checkBoth(ordering, fun("f", {fun("f", {x})}), fun("f", {x}), Comparison::Greater);
+    checkBoth(ordering, x, y, Comparison::Incomparable);
+    checkBoth(ordering, fun("f", {x}), y, Comparison::Incomparable);
+    checkBoth(ordering, fun("f", {x}), fun("g", {y}), Comparison::Incomparable);
+    checkBoth(ordering, fun("f", {a}), a, Comparison::Greater);
+
+    /* Atomi se porede kao termovi ciji je koren relacijski simbol */
+    Formula pfx = atom("p", {fun("f", {x})}), px = atom("p", {x}), py = atom("p", {y});
+    CHECK(ordering.compare(static_cast<const Atom*>(pfx.get()), static_cast<const Atom*>(px.get())) == Comparison::Greater);
+    CHECK(ordering.compare(static_cast<const Atom*>(px.get()), static_cast<const Atom*>(py.get())) == Comparison::Incomparable);
+}
+
+static void testKBO()
+{
+    KnuthBendixOrdering kbo;
+    testCommon(kbo);
+
+    Term x = var("x"), y = var("y");
+    Term a = fun("a"), b = fun("b");
+
+    /* Tezi term je veci, cak i kada mu je koren manje precedence */
+    checkBoth(kbo, fun("f", {fun("f", {fun("f", {a})})}), fun("h", {a, b}), Comparison::Greater);
+
+    /* Iste tezine: odlucuje precedenca, pa argumenti sleva nadesno */
+    checkBoth(kbo, fun("h", {a, a}), fun("f", {fun("f", {a})}), Comparison::Greater);
+    checkBoth(kbo, fun("h", {b, a}), fun("h", {a, b}), Comparison::Greater);
+
+    /* Zamenjeni argumenti ne mogu biti uporedivi, jer supstitucija moze obrnuti poredak */
+    checkBoth(kbo, fun("h", {x, y}), fun("h", {y, x}), Comparison::Incomparable);
+    checkBoth(kbo, fun("h", {x, x}), fun("f", {x}), Comparison::Greater);
+}
+
+static void testLPO()
+{
+    LexicographicPathOrdering lpo;
+    testCommon(lpo);
+
+    Term x = var("x"), y = var("y");
+    Term a = fun("a"), b = fun("b");
+
+    /* g je uveden posle f, pa je vece precedence */
+    checkBoth(lpo, fun("g", {fun("f", {x})}), fun("f", {fun("g", {x})}), Comparison::Greater);
+    checkBoth(lpo, fun("g", {x}), fun("f", {fun("f", {x})}), Comparison::Greater);
+
+    /* Simbol vece arnosti je veci, bez obzira na velicinu terma */
+    checkBoth(lpo, fun("h", {x, x}), fun("g", {fun("g", {fun("g", {x})})}), Comparison::Greater);
+
+    /* Isti koren: argumenti se porede leksikografski */
+    checkBoth(lpo, fun("h", {b, a}), fun("h", {a, b}), Comparison::Greater);
+    checkBoth(lpo, fun("h", {fun("f", {x}), y}), fun("h", {x, fun("f", {y})}), Comparison::Greater);
+    checkBoth(lpo, fun("h", {x, y}), fun("h", {y, x}), Comparison::Incomparable);
+}
+
+int main()
+{
+    /* Precedenca simbola iste arnosti je red uvodjenja: a < b i f < g */
+    fun("a");
+    fun("b");
+    fun("f", {var("x")});
+    fun("g", {var("x")});
+
+    testKBO();
+    testLPO();
+    return report("term_ordering");
+}
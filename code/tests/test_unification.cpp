@@ -0,0 +1,150 @@
+#include "check.h"
+#include "first_order_logic/unification.h"
+
+/**
+ * @brief unifiable - da li se termovi unifikuju, a ako se unifikuju proverava i unifikator
+ */
+static bool unifiable(const TermPairs &pairs)
+{
+    Substitution s;
+    if (!unify(pairs, s))
+    {
+        return false;
+    }
+    for (const auto &pair : pairs)
+    {
+        CHECK(pair.first->substitute(s) == pair.second->substitute(s));
+    }
+    return true;
+}
+
+static void testUnify()
+{
+    Term x = var("x"), y = var("y"), z = var("z"), w = var("w");
+    Term c = fun("c");
+
+    /* (g(y), x) i (f(x, h(x), y), f(g(z), w, z)) */
+    CHECK(unifiable({{fun("g", {y}), x}, {fun("f", {x, fun("h", {x}), y}), fun("f", {fun("g", {z}), w, z})}}));
+
+    /* Provera pojavljivanja, i preko lanca promenljivih */
+    CHECK(!unifiable({{x, fun("f", {x})}}));
+    CHECK(!unifiable({{x, fun("f", {y})}, {y, fun("g", {x})}}));
+    CHECK(unifiable({{x, fun("g", {y})}, {y, fun("g", {z})}}));
+
+    /* Sukob simbola i arnosti */
+    CHECK(!unifiable({{fun("g", {fun("h", {x})}), fun("g", {fun("g", {c})})}}));
+    CHECK(!unifiable({{fun("f", {x}), fun("f", {x, y})}}));
+
+    /* Atomi sa razlicitim relacijskim simbolima se ne unifikuju */
+    Formula px = atom("p", {x}), qa = atom("q", {c});
+    CHECK(!unify(static_cast<const Atom*>(px.get()), static_cast<const Atom*>(qa.get())));
+}
+
+static void testBanks()
+{
+    Term x = var("x");
+    Term a = fun("a"), b = fun("b");
+    Term fx = fun("f", {x});
+    Term l0 = Factory::make<VariableTerm>(bankVariable(0, 0));
+    Term fl0 = fun("f", {l0});
+    Term gl0x = fun("g", {l0, x}), gal0 = fun("g", {a, l0});
+
+    /* Lokalna promenljiva je u svakoj banci druga promenljiva, pa se premise ne preimenuju */
+    {
+        Unifier u;
+        std::vector<Substitution> envs;
+        CHECK(u.unify(l0, 0, fl0, 1) && u.solve(envs));
+        CHECK(envs.size() == 2);
+        CHECK(envs[0][bankVariable(0, 0)] == fun("f", {Factory::make<VariableTerm>(bankVariable(1, 0))}));
+    }
+
+    /* Promenljiva koja nije lokalna je ista u svim bankama */
+    {
+        Unifier u;
+        std::vector<Substitution> envs;
+        CHECK(!(u.unify(x, 0, fx, 1) && u.solve(envs)));
+    }
+    {
+        Unifier u;
+        CHECK(!(u.unify(x, 0, a, 0) && u.unify(x, 1, b, 1)));
+    }
+    {
+        Unifier u;
+        std::vector<Substitution> envs;
+        CHECK(u.unify(gl0x, 2, gal0, 1) && u.solve(envs));
+        CHECK(envs.size() == 3);
+        CHECK(envs[2][bankVariable(0, 0)] == a);
+        /* Vrednost promenljive koja nije lokalna je ista u svakom okruzenju */
+        CHECK(envs[0][Variable("x")] == envs[1][Variable("x")]);
+    }
+
+    /* BatchUnifier cita kandidate u zadatoj banci */
+    {
+        Formula pfl0 = atom("p", {fl0}), pfx = atom("p", {fx}), qa = atom("q", {a});
+        Formula pl0 = atom("p", {l0}), px = atom("p", {x});
+        AtomBatch candidates;
+        candidates.push_back(static_cast<const Atom*>(pfl0.get()));
+        candidates.push_back(static_cast<const Atom*>(pfx.get()));
+        candidates.push_back(static_cast<const Atom*>(qa.get()));
+        BatchUnifier batch;
+        const auto &local = batch.unify(static_cast<const Atom*>(pl0.get()), candidates, 1);
+        CHECK(local.size() == 2);
+        const auto &shared = batch.unify(static_cast<const Atom*>(px.get()), candidates, 1);
+        CHECK(shared.size() == 1 && shared[0].index == 0);
+    }
+}
+
+static void testUndo()
+{
+    Term x = var("x"), y = var("y");
+    Term a = fun("a"), b = fun("b");
+    Term fy = fun("f", {y});
+
+    Unifier u;
+    CHECK(u.unify(x, a));
+    Unifier::Mark mark = u.mark();
+    CHECK(!u.unify(x, b));
+    u.undo(mark);
+
+    mark = u.mark();
+    CHECK(u.unify(y, fy));
+    std::vector<Substitution> envs;
+    CHECK(!u.solve(envs));
+    u.undo(mark);
+
+    Substitution s;
+    CHECK(u.solve(s));
+    CHECK(s.size() == 1 && s[Variable("x")] == a);
+}
+
+static void testMatch()
+{
+    Term x = var("x"), y = var("y");
+    Term a = fun("a"), b = fun("b");
+
+    Substitution s;
+    CHECK(match(atom("p", {x, x}), atom("p", {a, a}), s));
+    s.clear();
+    CHECK(!match(atom("p", {x, x}), atom("p", {a, b}), s));
+    CHECK(s.empty());
+
+    /* Promenljive cilja se ne vezuju */
+    s.clear();
+    CHECK(match(fun("f", {x}), fun("f", {y}), s));
+    s.clear();
+    CHECK(!match(fun("f", {a}), fun("f", {y}), s));
+
+    /* Literali se uparuju samo ako su istog znaka */
+    s.clear();
+    CHECK(!match(neg(atom("p", {x})), atom("p", {a}), s));
+    CHECK(match(neg(atom("p", {x})), neg(atom("p", {a})), s));
+}
+
+int main()
+{
+    testUnify();
+    testBanks();
+    testUndo();
+    testMatch();
+    return report("unification");
+}